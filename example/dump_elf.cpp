@@ -9,9 +9,13 @@
  *   - Resolve a symbol by its exact address
  *   - Find the nearest symbol before a given address
  *   - Lookup a symbol by name
+ *   - Run many commands against one loaded binary (session mode)
+ *   - Run one command over many binaries in parallel (batch mode)
  *
  * Usage:
  *   dump_elf <binary> <command> [argument]
+ *   dump_elf [vdso] <command> [argument]   (the vDSO of this process)
+ *   dump_elf [-j threads] <binary|@list>... -- <command> [argument]
  *
  * Commands:
  *   sections                  Show all ELF sections (default)
@@ -19,69 +23,250 @@
  *   functions                 Show function symbols only
  *   resolve <hex_address>     Find symbol at exact address
  *   resolve-nearest <hex>     Find closest symbol before address
- *   find <symbol_name>        Lookup symbol by name
+ *   find <symbol_name>        Lookup symbol by name (raw or C++ qualified)
  *   section-of <hex_address>  Find section containing the given address
+ *   range <hex_lo> <hex_hi>   Show sections and symbols intersecting [lo, hi)
  *   metadata                  Show ELF metadata (entry point, architecture, type, flags)
+ *   largest [count] [type]    Show the largest symbols (type: all, functions, objects)
+ *   size-range <min> [max]    Show symbols whose size lies in [min, max] bytes
+ *   sizes [count]             Attribute VM and file size to segments, sections and symbols
+ *   grep <regex>              Show symbols whose name matches a regular expression
+ *   export <format> [hex_bias] Write symbols to stdout (format: perf, breakpad, list)
+ *   hash [section...]         Print XXH64 hashes of section contents (default .text .rodata .dynsym)
+ *   diff <other> [type]       Show sections and symbols added, removed or resized in <other>
+ *   session [script]          Run commands from a script file or stdin, one per line
  *
  * Examples:
  *   dump_elf my_binary.elf symbols
  *   dump_elf my_binary.elf resolve 0x401000
+ *   printf 'find main\nsection-of 0x1129\n' | dump_elf my_binary.elf session
+ *   find /usr/lib -name '*.so*' | dump_elf -j 16 @- -- metadata
  */
 
 #include "minielf/MiniELF.hpp"
+#include "minielf/ByteSource.hpp"
+#include "minielf/NameScanner.hpp"
+#include "minielf/DemangledIndex.hpp"
+#include "minielf/SymbolExporter.hpp"
+#include "minielf/ProcessImage.hpp"
+#include "minielf/ElfDiff.hpp"
+#include "minielf/SizeReport.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <memory>
 #include <sstream>
 #include <cctype>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unistd.h>
+
+// Opens a binary; "[vdso]" names the vDSO of this process, parsed from memory
+// and shared with the process image cache.
+minielf::MiniELF openBinary(const std::string& path) {
+    static minielf::ProcessImageCache processImages;
+    if (path == "[vdso]") {
+        if (auto vdso = processImages.getVdso(static_cast<int>(getpid()))) return *vdso;
+    }
+    return minielf::MiniELF(path);
+}
+
+// Loaded binary plus the optional search indexes, built on first use and
+// kept warm for the following commands of a session.
+struct Session {
+    explicit Session(minielf::MiniELF file) : elf(std::move(file)) {}
+
+    minielf::MiniELF elf;
+    std::unique_ptr<minielf::DemangledIndex> demangled;
+    std::unique_ptr<minielf::NameScanner> scanner;
+
+    const minielf::DemangledIndex& demangledIndex() {
+        if (!demangled) demangled = std::make_unique<minielf::DemangledIndex>(elf);
+        return *demangled;
+    }
+
+    const minielf::NameScanner& nameScanner() {
+        if (!scanner) scanner = std::make_unique<minielf::NameScanner>(elf);
+        return *scanner;
+    }
+
+    // Hashes the named sections on first use, reading them back from the file;
+    // false if the binary has no file to read (e.g. "[vdso]").
+    bool hashSections(const std::vector<std::string>& names) {
+        minielf::FileByteSource source(elf.getFilePath());
+        return source.isOpen() && elf.hashSections(source, names);
+    }
+};
 
 // Prints a formatted table of ELF sections.
-void printSectionTable(const std::vector<minielf::Section>& sections) {
-    std::cout << std::left << std::setw(20) << "Address"
-              << std::setw(25) << "Name"
-              << "Size (bytes)\n";
-    std::cout << std::string(60, '-') << "\n";
+void printSectionTable(std::ostream& out, const std::vector<minielf::Section>& sections) {
+    out << std::left << std::setw(20) << "Address"
+        << std::setw(25) << "Name"
+        << "Size (bytes)\n";
+    out << std::string(60, '-') << "\n";
     for (const auto& sec : sections) {
-        std::cout << std::left
-                  << "0x" << std::setw(18) << std::hex << sec.address
-                  << std::setw(25) << sec.name
-                  << std::dec << sec.size << "\n";
+        out << std::left
+            << "0x" << std::setw(18) << std::hex << sec.address
+            << std::setw(25) << sec.name
+            << std::dec << sec.size << "\n";
     }
 }
 
 // Prints a formatted table of ELF symbols, optionally filtering for functions only.
-void printSymbolTable(const std::vector<minielf::Symbol>& symbols, bool functionsOnly) {
-    std::cout << std::left << std::setw(20) << "Address"
-              << std::setw(35) << "Name"
-              << "Size (bytes)\n";
-    std::cout << std::string(70, '-') << "\n";
+void printSymbolTable(std::ostream& out, const std::vector<minielf::Symbol>& symbols, bool functionsOnly) {
+    out << std::left << std::setw(20) << "Address"
+        << std::setw(35) << "Name"
+        << "Size (bytes)\n";
+    out << std::string(70, '-') << "\n";
     for (const auto& sym : symbols) {
         if (functionsOnly && !sym.isFunction()) continue;
-        std::cout << std::left
-                  << "0x" << std::setw(18) << std::hex << sym.address
-                  << std::setw(35) << sym.name
-                  << std::dec << sym.size << "\n";
+        out << std::left
+            << "0x" << std::setw(18) << std::hex << sym.address
+            << std::setw(35) << sym.name
+            << std::dec << sym.size << "\n";
+    }
+}
+
+// Prints a formatted table of symbols referenced by a span or range, adding their type.
+template <typename Symbols>
+void printSymbolSpan(std::ostream& out, const Symbols& symbols) {
+    out << std::left << std::setw(20) << "Address"
+        << std::setw(12) << "Size"
+        << std::setw(8) << "Type"
+        << "Name\n";
+    out << std::string(70, '-') << "\n";
+    for (const auto* sym : symbols) {
+        const char* type = sym->isFunction() ? "FUNC"
+                         : sym->type == minielf::SymbolType::OBJECT ? "OBJECT" : "OTHER";
+        out << std::left
+            << "0x" << std::setw(18) << std::hex << sym->address
+            << std::dec << std::setw(12) << sym->size
+            << std::setw(8) << type
+            << sym->name << "\n";
     }
 }
 
+// Parses a symbol type filter for the size commands ("all" yields no filter).
+bool parseTypeFilter(const std::string& s, std::optional<minielf::SymbolType>& out) {
+    if (s == "all") out.reset();
+    else if (s == "functions" || s == "func") out = minielf::SymbolType::FUNC;
+    else if (s == "objects" || s == "object") out = minielf::SymbolType::OBJECT;
+    else return false;
+    return true;
+}
+
 // Prints usage instructions for the CLI tool.
 void printUsage() {
     std::cerr << "\nMiniELF CLI - ELF64 Inspection Tool\n";
     std::cerr << "-------------------------------------\n";
     std::cerr << "Usage:\n";
-    std::cerr << "  dump_elf <binary> <command> [argument]\n\n";
+    std::cerr << "  dump_elf <binary> <command> [argument]\n";
+    std::cerr << "  dump_elf [-j threads] <binary|@list>... -- <command> [argument]\n";
+    std::cerr << "      Run one command over many binaries; @list reads paths from a file (@- = stdin)\n";
+    std::cerr << "  <binary> may be [vdso] to inspect the vDSO of the running kernel\n\n";
     std::cerr << "Commands:\n";
     std::cerr << "  sections                  Show all ELF sections (default)\n";
     std::cerr << "  symbols                   List all symbols\n";
     std::cerr << "  functions                 Show function symbols only\n";
     std::cerr << "  resolve <hex_address>     Find symbol at exact address\n";
     std::cerr << "  resolve-nearest <hex>     Find closest symbol before address\n";
-    std::cerr << "  find <symbol_name>        Lookup symbol by name\n";
+    std::cerr << "  find <symbol_name>        Lookup symbol by name (raw or C++ qualified)\n";
     std::cerr << "  section-of <hex_address>  Find section containing the given address\n";
+    std::cerr << "  range <hex_lo> <hex_hi>   Show sections and symbols intersecting [lo, hi)\n";
     std::cerr << "  section <section_name>    Lookup section by name\n";
-    std::cerr << "  metadata                  Show ELF metadata (entry point, architecture, type, flags)\n\n";
+    std::cerr << "  metadata                  Show ELF metadata (entry point, architecture, type, flags)\n";
+    std::cerr << "  largest [count] [type]    Show the largest symbols (type: all, functions, objects)\n";
+    std::cerr << "  size-range <min> [max]    Show symbols whose size lies in [min, max] bytes\n";
+    std::cerr << "  sizes [count]             Attribute VM and file size to segments, sections and symbols\n";
+    std::cerr << "  grep <regex>              Show symbols whose name matches a regular expression\n";
+    std::cerr << "  export <format> [hex_bias] Write symbols to stdout (format: perf, breakpad, list)\n";
+    std::cerr << "  hash [section...]         Print XXH64 hashes of section contents (default .text .rodata .dynsym)\n";
+    std::cerr << "  diff <other> [type]       Show sections and symbols added, removed or resized in <other>\n";
+    std::cerr << "  session [script]          Run commands from a script file or stdin, one per line\n\n";
     std::cerr << "Examples:\n";
     std::cerr << "  dump_elf my_binary.elf symbols\n";
-    std::cerr << "  dump_elf my_binary.elf resolve 0x401000\n\n";
+    std::cerr << "  dump_elf my_binary.elf resolve 0x401000\n";
+    std::cerr << "  dump_elf my_binary.elf export perf 0x7f0000000000 > /tmp/perf-1234.map\n";
+    std::cerr << "  dump_elf [vdso] functions\n";
+    std::cerr << "  dump_elf old/libfoo.so diff new/libfoo.so functions\n";
+    std::cerr << "  printf 'find main\\nsection-of 0x1129\\n' | dump_elf my_binary.elf session\n";
+    std::cerr << "  find /usr/lib -name '*.so*' | dump_elf -j 16 @- -- metadata\n\n";
+}
+
+// Prints the section and symbol differences between two builds with totals.
+void printDiff(std::ostream& out, const minielf::ElfDiff& diff, std::optional<minielf::SymbolType> type) {
+    auto sizes = [&out](const char* mark, const std::string& name, const uint64_t* before, const uint64_t* after) {
+        out << "  " << mark << ' ' << std::left << std::setw(40) << name << std::right;
+        if (before && after) {
+            const int64_t delta = static_cast<int64_t>(*after) - static_cast<int64_t>(*before);
+            out << *before << " -> " << *after << " (" << (delta >= 0 ? "+" : "") << delta << ")";
+        } else {
+            out << *(before ? before : after);
+        }
+        out << '\n';
+    };
+    auto summary = [&out](const char* what, const minielf::DiffStats& stats) {
+        out << what << ": " << stats.added << " added, " << stats.removed << " removed, "
+            << stats.changed << " changed, " << (stats.sizeDelta >= 0 ? "+" : "") << stats.sizeDelta << " bytes\n";
+    };
+
+    out << "Section changes:\n";
+    const auto sectionStats = diff.diffSections([&](const minielf::SectionDiff& d) {
+        const std::string& name = (d.before ? d.before : d.after)->name;
+        switch (d.kind) {
+        case minielf::DiffKind::Added:    sizes("+", name, nullptr, &d.after->size); break;
+        case minielf::DiffKind::Removed:  sizes("-", name, &d.before->size, nullptr); break;
+        case minielf::DiffKind::Resized:  sizes("~", name, &d.before->size, &d.after->size); break;
+        case minielf::DiffKind::Modified: out << "  * " << std::left << std::setw(40) << name << std::right
+                                              << "contents changed\n"; break;
+        }
+    });
+    out << "Symbol changes:\n";
+    auto onSymbol = [&](const minielf::SymbolDiff& d) {
+        const std::string& name = (d.before ? d.before : d.after)->name;
+        if (d.kind == minielf::DiffKind::Added) sizes("+", name, nullptr, &d.after->size);
+        else if (d.kind == minielf::DiffKind::Removed) sizes("-", name, &d.before->size, nullptr);
+        else sizes("~", name, &d.before->size, &d.after->size);
+    };
+    const auto symbolStats = type ? diff.diffSymbols(*type, onSymbol) : diff.diffSymbols(onSymbol);
+    summary("Sections", sectionStats);
+    summary("Symbols", symbolStats);
+}
+
+// Prints VM and file sizes by segment and section, then the largest symbols.
+void printSizes(std::ostream& out, const minielf::SizeReport& report, size_t count) {
+    auto row = [&out](uint64_t vm, uint64_t file, const std::string& indent, const std::string& name) {
+        out << std::setw(12) << vm << std::setw(12) << file << "  " << indent << name << '\n';
+    };
+    out << std::setw(12) << "VM SIZE" << std::setw(12) << "FILE SIZE" << "  NAME\n";
+    const auto& sections = report.getSections();
+    for (size_t s = 0, i = 0; s < report.getSegments().size(); ++s) {
+        const auto& segment = report.getSegments()[s];
+        row(segment.vmSize, segment.fileSize, "", segment.name);
+        for (; i < sections.size() && sections[i].parent == s; ++i)
+            row(sections[i].vmSize, sections[i].fileSize, "  ", sections[i].name);
+    }
+    row(report.getVmSize(), report.getFileSize(), "", "TOTAL");
+
+    // Largest symbols by VM size, then file size
+    std::vector<const minielf::SymbolSize*> symbols;
+    symbols.reserve(report.getSymbols().size());
+    for (const auto& sym : report.getSymbols())
+        if (sym.symbol) symbols.push_back(&sym);
+    count = std::min(count, symbols.size());
+    std::partial_sort(symbols.begin(), symbols.begin() + count, symbols.end(),
+        [](const minielf::SymbolSize* a, const minielf::SymbolSize* b) {
+            return a->vmSize != b->vmSize ? a->vmSize > b->vmSize : a->fileSize > b->fileSize;
+        });
+    out << "\nLargest symbols:\n";
+    for (size_t i = 0; i < count; ++i)
+        row(symbols[i]->vmSize, symbols[i]->fileSize, "", symbols[i]->symbol->name + " (" + sections[symbols[i]->section].name + ")");
 }
 
 bool isValidHex(const std::string& s) {
@@ -94,112 +279,459 @@ bool isValidHex(const std::string& s) {
     return true;
 }
 
-static void printHex64(uint64_t addr) {
-    std::cout << "0x" << std::hex << std::setw(8) << std::setfill('0') << addr << std::dec;
+static void printHex64(std::ostream& out, uint64_t addr) {
+    out << "0x" << std::hex << std::setw(8) << std::setfill('0') << addr << std::dec << std::setfill(' ');
 }
 
-int main(int argc, char** argv) {
-    if (argc < 2) {
-        printUsage();
-        return 1;
-    }
-
-    minielf::MiniELF elf(argv[1]);
-    if (!elf.isValid()) {
-        std::cerr << elf.getLastError() << "\n";
-        return 1;
-    }
-
-    std::string command = argc >= 3 ? argv[2] : "sections";
+// Runs one command; args[0] is the command name. Returns the exit status.
+int runCommand(Session& session, const std::vector<std::string>& args, std::ostream& out, std::ostream& err) {
+    const minielf::MiniELF& elf = session.elf;
+    const std::string command = args.empty() ? "sections" : args[0];
+    const size_t argc = args.size();
 
     if (command == "sections") {
-        printSectionTable(elf.getSections());
+        printSectionTable(out, elf.getSections());
     } else if (command == "symbols") {
-        printSymbolTable(elf.getSymbols(), false);
+        printSymbolTable(out, elf.getSymbols(), false);
     } else if (command == "functions") {
-        printSymbolTable(elf.getSymbols(), true);
-    } else if (command == "resolve" && argc == 4) {
-        std::string input = argv[3];
+        printSymbolTable(out, elf.getSymbols(), true);
+    } else if (command == "resolve" && argc == 2) {
+        const std::string& input = args[1];
         if (!isValidHex(input)) {
-            std::cerr << "Invalid address format: " << input << '\n';
+            err << "Invalid address format: " << input << '\n';
             return 1;
         }
         uint64_t addr = std::stoull(input, nullptr, 16);
         const auto* sym = elf.getSymbolByAddress(addr);
         if (sym) {
-            std::cout << "Resolved: " << sym->name << "\t@ 0x"
-                    << std::hex << sym->address << std::dec
-                    << " (" << sym->size << " bytes)\n";
+            out << "Resolved: " << sym->name << "\t@ 0x"
+                << std::hex << sym->address << std::dec
+                << " (" << sym->size << " bytes)\n";
         } else {
-            std::cout << "No symbol found at 0x" << std::hex << addr << '\n';
+            out << "No symbol found at 0x" << std::hex << addr << std::dec << '\n';
         }
-        return 0;
-    } else if (command == "resolve-nearest" && argc == 4) {
-        std::string input = argv[3];
+    } else if (command == "resolve-nearest" && argc == 2) {
+        const std::string& input = args[1];
         if (!isValidHex(input)) {
-            std::cerr << "Invalid address format: " << input << '\n';
+            err << "Invalid address format: " << input << '\n';
             return 1;
         }
         uint64_t addr = std::stoull(input, nullptr, 16);
         const auto* sym = elf.getNearestSymbol(addr);
         if (sym) {
-            std::cout << "Nearest: " << sym->name << "\t@ 0x"
-                    << std::hex << sym->address << std::dec
-                    << " (" << sym->size << " bytes)\n";
+            out << "Nearest: " << sym->name << "\t@ 0x"
+                << std::hex << sym->address << std::dec
+                << " (" << sym->size << " bytes)\n";
         } else {
-            std::cout << "No symbol found before 0x" << std::hex << addr << '\n';
+            out << "No symbol found before 0x" << std::hex << addr << std::dec << '\n';
         }
-        return 0;
-    } else if (command == "find" && argc == 4) {
-        const auto* sym = elf.getSymbolByName(argv[3]);
-        if (sym) {
-            std::cout << "Found: " << sym->name << " @ 0x"
-                      << std::hex << sym->address << " (" << std::dec << sym->size << " bytes)\n";
-        } else {
-            std::cout << "Symbol not found: " << argv[3] << "\n";
+    } else if (command == "find" && argc == 2) {
+        // Print every definition, e.g. file-local statics sharing a name
+        const auto matches = elf.getSymbolsByName(args[1]);
+        for (const auto* sym : matches) {
+            out << "Found: " << sym->name << " @ 0x"
+                << std::hex << sym->address << " (" << std::dec << sym->size << " bytes)\n";
+        }
+        // Fall back to demangled names: full signature or qualified name
+        std::vector<const minielf::Symbol*> demangled;
+        if (matches.empty()) {
+            demangled = session.demangledIndex().findQualified(args[1]);
+        }
+        for (const auto* sym : demangled) {
+            out << "Found: " << minielf::DemangledIndex::demangle(sym->name)
+                << " [" << sym->name << "] @ 0x"
+                << std::hex << sym->address << " (" << std::dec << sym->size << " bytes)\n";
+        }
+        if (matches.empty() && demangled.empty()) {
+            out << "Symbol not found: " << args[1] << "\n";
         }
-    } else if (command == "section-of" && argc == 4) {
+    } else if (command == "range" && argc == 3) {
+        if (!isValidHex(args[1]) || !isValidHex(args[2])) {
+            err << "Invalid address range: " << args[1] << ' ' << args[2] << '\n';
+            return 1;
+        }
+        const uint64_t lo = std::stoull(args[1], nullptr, 16);
+        const uint64_t hi = std::stoull(args[2], nullptr, 16);
+        for (const auto* sec : elf.getSectionsInRange(lo, hi)) {
+            out << "Section: " << sec->name << " @ 0x" << std::hex << sec->address
+                << std::dec << " (" << sec->size << " bytes)\n";
+        }
+        printSymbolSpan(out, elf.getSymbolsInRange(lo, hi));
+    } else if (command == "section-of" && argc == 2) {
         uint64_t addr = 0;
         try {
-            addr = std::stoull(argv[3], nullptr, 16);
+            addr = std::stoull(args[1], nullptr, 16);
         } catch (...) {
-            std::cerr << "Invalid address: " << argv[3] << '\n';
+            err << "Invalid address: " << args[1] << '\n';
             return 1;
         }
 
         const auto* sec = elf.getSectionByAddress(addr);
         if (sec) {
-            std::cout << "Address 0x" << std::hex << addr << " is in section: " << sec->name
-                    << " @ 0x" << sec->address << " (" << std::dec << sec->size << " bytes)\n";
+            out << "Address 0x" << std::hex << addr << " is in section: " << sec->name
+                << " @ 0x" << sec->address << " (" << std::dec << sec->size << " bytes)\n";
         } else {
-            std::cout << "Address 0x" << std::hex << addr << " not found in any section.\n";
+            out << "Address 0x" << std::hex << addr << std::dec << " not found in any section.\n";
         }
-        return 0;
-    } else if (command == "section" && argc == 4) {
+    } else if (command == "section" && argc == 2) {
         // Lookup section by name
-        const auto* sec = elf.getSectionByName(argv[3]);
+        const auto* sec = elf.getSectionByName(args[1]);
         if (sec) {
-            std::cout << "Section: " << sec->name
-                    << " @ 0x" << std::hex << sec->address
-                    << " (" << std::dec << sec->size << " bytes)\n";
+            out << "Section: " << sec->name
+                << " @ 0x" << std::hex << sec->address
+                << " (" << std::dec << sec->size << " bytes)\n";
         } else {
-            std::cout << "Section not found: " << argv[3] << "\n";
+            out << "Section not found: " << args[1] << "\n";
         }
-        return 0;
     } else if (command == "metadata") {
         const auto meta = elf.getMetadata();
-        std::cout << "ELF Metadata:\n";
-        std::cout << "  Entry point : ";
-        printHex64(meta.entry);
-        std::cout << "\n";
-        std::cout << "  Machine     : " << meta.machine << "\n";
-        std::cout << "  Type        : " << meta.type << "\n";
-        std::cout << "  Version     : " << meta.version << "\n";
-        std::cout << "  Flags       : " << meta.flags << "\n";
+        out << "ELF Metadata:\n";
+        out << "  Entry point : ";
+        printHex64(out, meta.entry);
+        out << "\n";
+        out << "  Machine     : " << meta.machine << "\n";
+        out << "  Type        : " << meta.type << "\n";
+        out << "  Version     : " << meta.version << "\n";
+        out << "  Flags       : " << meta.flags << "\n";
+    } else if (command == "largest" && argc <= 3) {
+        size_t count = 20;
+        std::optional<minielf::SymbolType> type;
+        try {
+            if (argc >= 2) count = std::stoull(args[1]);
+        } catch (...) {
+            err << "Invalid count: " << args[1] << '\n';
+            return 1;
+        }
+        if (argc == 3 && !parseTypeFilter(args[2], type)) {
+            err << "Invalid symbol type: " << args[2] << '\n';
+            return 1;
+        }
+        printSymbolSpan(out, type ? elf.getLargestSymbols(count, *type) : elf.getLargestSymbols(count));
+    } else if (command == "sizes" && argc <= 2) {
+        size_t count = 20;
+        try {
+            if (argc == 2) count = std::stoull(args[1]);
+        } catch (...) {
+            err << "Invalid count: " << args[1] << '\n';
+            return 1;
+        }
+        printSizes(out, minielf::SizeReport(elf), count);
+    } else if (command == "size-range" && (argc == 2 || argc == 3)) {
+        uint64_t minSize = 0;
+        uint64_t maxSize = std::numeric_limits<uint64_t>::max();
+        try {
+            minSize = std::stoull(args[1], nullptr, 0);
+            if (argc == 3) maxSize = std::stoull(args[2], nullptr, 0);
+        } catch (...) {
+            err << "Invalid size range\n";
+            return 1;
+        }
+        printSymbolSpan(out, elf.getSymbolsBySize(minSize, maxSize));
+    } else if (command == "grep" && argc == 2) {
+        // Search straight over the string table, no index needed
+        std::vector<uint32_t> ids;
+        try {
+            ids = session.nameScanner().findMatching(args[1]);
+        } catch (const std::regex_error& e) {
+            err << "Invalid regular expression: " << e.what() << '\n';
+            return 1;
+        }
+        std::vector<const minielf::Symbol*> matches;
+        for (uint32_t id : ids) matches.push_back(&elf.getSymbols()[id]);
+        printSymbolSpan(out, minielf::SymbolSpan(matches.data(), matches.data() + matches.size()));
+    } else if (command == "export" && (argc == 2 || argc == 3)) {
+        const std::string& format = args[1];
+        minielf::ExportFormat fmt;
+        if (format == "perf") fmt = minielf::ExportFormat::PerfMap;
+        else if (format == "breakpad") fmt = minielf::ExportFormat::Breakpad;
+        else if (format == "list") fmt = minielf::ExportFormat::SymbolList;
+        else {
+            err << "Unknown export format: " << format << '\n';
+            return 1;
+        }
+        uint64_t bias = 0;
+        if (argc == 3) {
+            if (!isValidHex(args[2])) {
+                err << "Invalid bias: " << args[2] << '\n';
+                return 1;
+            }
+            bias = std::stoull(args[2], nullptr, 16);
+        }
+        minielf::SymbolExporter exporter(elf);
+        if (!exporter.canWrite(fmt)) {
+            err << "Cannot export " << format << ": " << elf.getFilePath() << " has no build ID\n";
+            return 1;
+        }
+        exporter.write(out, fmt, bias);
+    } else if (command == "diff" && (argc == 2 || argc == 3)) {
+        std::optional<minielf::SymbolType> type;
+        if (argc == 3 && !parseTypeFilter(args[2], type)) {
+            err << "Invalid symbol type: " << args[2] << '\n';
+            return 1;
+        }
+        minielf::MiniELF after(args[1]);
+        if (!after.isValid()) {
+            err << after.getLastError() << '\n';
+            return 1;
+        }
+        // Only equally sized sections can differ in content alone; hash just those
+        std::vector<std::string> sameSize;
+        for (const auto& sec : after.getSections()) {
+            const auto* old = elf.getSectionByName(sec.name);
+            if (old && old->size == sec.size && sec.size != 0) sameSize.push_back(sec.name);
+        }
+        if (!sameSize.empty()) {
+            minielf::FileByteSource afterSource(args[1]);
+            if (!session.hashSections(sameSize) || !afterSource.isOpen() || !after.hashSections(afterSource, sameSize))
+                err << "Cannot read " << elf.getFilePath() << " back; equally sized sections are not compared by content\n";
+        }
+        printDiff(out, minielf::ElfDiff(elf, after), type);
+    } else if (command == "hash") {
+        std::vector<std::string> names(args.begin() + 1, args.end());
+        if (names.empty()) names = {".text", ".rodata", ".dynsym"};
+        if (!session.hashSections(names)) {
+            err << "Cannot hash sections: " << elf.getFilePath() << " cannot be read back\n";
+            return 1;
+        }
+        for (const auto& sec : elf.getSections()) {
+            if (!sec.hash || std::find(names.begin(), names.end(), sec.name) == names.end()) continue;
+            out << std::hex << std::setw(16) << std::setfill('0') << *sec.hash << std::setfill(' ') << std::dec
+                << "  " << sec.name << '\n';
+        }
     } else {
-        std::cerr << "Unknown or malformed command.\n";
+        err << "Unknown or malformed command.\n";
         return 1;
     }
 
     return 0;
-}
\ No newline at end of file
+}
+
+// Splits a session line into words; double quotes group words containing spaces.
+std::vector<std::string> splitCommandLine(const std::string& line) {
+    std::vector<std::string> words;
+    std::string word;
+    bool quoted = false, inWord = false;
+    for (char c : line) {
+        if (c == '"') {
+            quoted = !quoted;
+            inWord = true;
+        } else if (!quoted && std::isspace(static_cast<unsigned char>(c))) {
+            if (inWord) words.push_back(word);
+            word.clear();
+            inWord = false;
+        } else {
+            word.push_back(c);
+            inWord = true;
+        }
+    }
+    if (inWord) words.push_back(word);
+    return words;
+}
+
+// Runs commands line by line against one loaded binary, timing each of them.
+// Blank lines and lines starting with '#' are skipped; "quit" or "exit" ends the session.
+int runSession(Session& session, std::istream& in, bool interactive) {
+    int status = 0;
+    std::string line;
+    while (true) {
+        if (interactive) std::cerr << "minielf> " << std::flush;
+        if (!std::getline(in, line)) break;
+        const auto args = splitCommandLine(line);
+        if (args.empty() || args[0][0] == '#') continue;
+        if (args[0] == "quit" || args[0] == "exit") break;
+        if (args[0] == "session") {
+            std::cerr << "Sessions cannot be nested.\n";
+            status = 1;
+            continue;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const int result = runCommand(session, args, std::cout, std::cerr);
+        const auto elapsed = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        std::cout.flush();
+        std::cerr << "[" << args[0] << ": " << std::fixed << std::setprecision(3)
+                  << elapsed << " ms" << (result != 0 ? ", failed" : "") << "]\n";
+        std::cerr.unsetf(std::ios::floatfield);
+        if (result != 0) status = result;
+    }
+    return status;
+}
+
+// Name of a parse stage for failure reports.
+const char* stageName(minielf::MiniELF::ParseStage stage) {
+    switch (stage) {
+    case minielf::MiniELF::ParseStage::Header:         return "header";
+    case minielf::MiniELF::ParseStage::SectionHeaders: return "section headers";
+    case minielf::MiniELF::ParseStage::Symbols:        return "symbols";
+    case minielf::MiniELF::ParseStage::ProgramHeaders: return "program headers";
+    }
+    return "unknown";
+}
+
+// Appends text to out, prefixing every line.
+void appendPrefixed(std::string& out, const std::string& prefix, const std::string& text) {
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t nl = text.find('\n', pos);
+        size_t end = nl == std::string::npos ? text.size() : nl + 1;
+        out += prefix;
+        out.append(text, pos, end - pos);
+        if (nl == std::string::npos) out += '\n';
+        pos = end;
+    }
+}
+
+// Output and failure description of one binary in a batch.
+struct BatchResult {
+    std::string output;
+    std::string failure;
+    bool done = false;
+};
+
+// Runs one command over many binaries on a pool of worker threads. Output is
+// printed in input order as soon as each binary's turn comes, every line
+// prefixed with its path; errors are kept off stdout and summarized on stderr
+// at the end.
+int runBatch(const std::vector<std::string>& paths, const std::vector<std::string>& args, unsigned threads) {
+    std::vector<BatchResult> results(paths.size());
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::atomic<size_t> next{0};
+
+    auto worker = [&]() {
+        for (size_t i; (i = next.fetch_add(1)) < paths.size();) {
+            BatchResult result;
+            const std::string prefix = paths[i] + ": ";
+            minielf::MiniELF elf = openBinary(paths[i]);
+            if (!elf.isValid()) {
+                result.failure = std::string(stageName(elf.getFailureStage())) + " stage: " + elf.getLastError();
+            } else {
+                Session session(std::move(elf));
+                std::ostringstream out, err;
+                if (runCommand(session, args, out, err) != 0) {
+                    result.failure = "command failed: " + err.str();
+                    if (!result.failure.empty() && result.failure.back() == '\n') result.failure.pop_back();
+                }
+                appendPrefixed(result.output, prefix, out.str());
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            result.done = true;
+            results[i] = std::move(result);
+            ready.notify_all();
+        }
+    };
+
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(paths.size())));
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) pool.emplace_back(worker);
+
+    size_t failed = 0;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        std::string output;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [&] { return results[i].done; });
+            output.swap(results[i].output);
+        }
+        std::cout << output;
+        if (!results[i].failure.empty()) ++failed;
+    }
+    for (auto& t : pool) t.join();
+    std::cout.flush();
+
+    std::cerr << "Processed " << paths.size() << " binaries, " << failed << " failed\n";
+    for (size_t i = 0; i < paths.size(); ++i) {
+        if (!results[i].failure.empty()) std::cerr << "  " << paths[i] << ": " << results[i].failure << '\n';
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+// Reads one path per line from a list file ("-" reads stdin).
+bool readPathList(const std::string& list, std::vector<std::string>& paths) {
+    std::ifstream file;
+    if (list != "-") {
+        file.open(list);
+        if (!file) return false;
+    }
+    std::istream& in = list == "-" ? std::cin : file;
+    std::string line;
+    while (std::getline(in, line)) {
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ')) line.pop_back();
+        if (!line.empty()) paths.push_back(line);
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+
+    // Batch mode: dump_elf [-j threads] <binary|@list>... -- <command> [argument]
+    char** separator = std::find_if(argv + 1, argv + argc,
+        [](const char* arg) { return std::string(arg) == "--"; });
+    if (separator != argv + argc) {
+        unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<std::string> paths;
+        for (char** arg = argv + 1; arg != separator; ++arg) {
+            const std::string value = *arg;
+            if (value == "-j" && arg + 1 != separator) {
+                try {
+                    threads = static_cast<unsigned>(std::stoul(*++arg));
+                } catch (...) {
+                    std::cerr << "Invalid thread count: " << *arg << '\n';
+                    return 1;
+                }
+            } else if (value.size() > 1 && value[0] == '@') {
+                if (!readPathList(value.substr(1), paths)) {
+                    std::cerr << "Cannot open file list: " << value.substr(1) << '\n';
+                    return 1;
+                }
+            } else {
+                paths.push_back(value);
+            }
+        }
+        std::vector<std::string> args(separator + 1, argv + argc);
+        if (paths.empty() || (!args.empty() && args[0] == "session")) {
+            printUsage();
+            return 1;
+        }
+        std::ios::sync_with_stdio(false);
+        return runBatch(paths, args, threads);
+    }
+
+    const auto loadStart = std::chrono::steady_clock::now();
+    minielf::MiniELF elf = openBinary(argv[1]);
+    if (!elf.isValid()) {
+        std::cerr << elf.getLastError() << "\n";
+        return 1;
+    }
+    Session session(std::move(elf));
+
+    std::vector<std::string> args(argv + 2, argv + argc);
+    if (!args.empty() && args[0] == "session") {
+        const auto elapsed = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - loadStart).count();
+        std::cerr << "[load " << argv[1] << ": " << std::fixed << std::setprecision(3)
+                  << elapsed << " ms]\n";
+        std::cerr.unsetf(std::ios::floatfield);
+        if (args.size() > 2) {
+            std::cerr << "Unknown or malformed command.\n";
+            return 1;
+        }
+        if (args.size() == 2) {
+            std::ifstream script(args[1]);
+            if (!script) {
+                std::cerr << "Cannot open script: " << args[1] << '\n';
+                return 1;
+            }
+            return runSession(session, script, false);
+        }
+        return runSession(session, std::cin, isatty(STDIN_FILENO) != 0);
+    }
+
+    std::ios::sync_with_stdio(false);
+    return runCommand(session, args, std::cout, std::cerr);
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <future>
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace minielf {
+
+namespace detail {
+class MappedFile;
+}
+
+/**
+ * @brief One read of a ByteSource::readBatch() call.
+ */
+struct ReadRequest {
+    uint64_t offset = 0;   ///< Offset in the source
+    void* buffer = nullptr;///< Destination, at least size bytes
+    size_t size = 0;       ///< Number of bytes to read
+    size_t bytesRead = 0;  ///< Filled in by the source (short at end of data or on error)
+};
+
+/**
+ * @brief Random-access source of ELF image bytes.
+ *
+ * MiniELF parses through this interface, so images can come from files,
+ * memory, blob stores or decrypting containers without temporary files.
+ * Implementations provide readAt(); sources whose bytes are addressable in
+ * memory also override view() so the parser can read tables in place, and
+ * sources with high per-request latency override readBatch() to issue the
+ * reads of a parsing step concurrently.
+ *
+ * Sources are used from one thread at a time by MiniELF.
+ */
+class ByteSource {
+public:
+    virtual ~ByteSource() = default;
+
+    /**
+     * @brief Get the total size of the data.
+     * @return Size in bytes.
+     */
+    virtual uint64_t size() const = 0;
+
+    /**
+     * @brief Read bytes at an offset.
+     * @param offset Offset in the source.
+     * @param buffer Destination buffer.
+     * @param size   Number of bytes to read.
+     * @return Number of bytes read; less than size at the end of the data or on error.
+     */
+    virtual size_t readAt(uint64_t offset, void* buffer, size_t size) const = 0;
+
+    /**
+     * @brief Get a zero-copy view of a byte range, if the source supports it.
+     *
+     * The pointer stays valid for the lifetime of the source and carries no
+     * alignment guarantee.
+     * @param offset Offset in the source.
+     * @param size   Length of the range.
+     * @return Pointer to the bytes, or nullptr if the range is out of bounds
+     *         or the source cannot provide views (the default).
+     */
+    virtual const char* view(uint64_t offset, size_t size) const;
+
+    /**
+     * @brief Start a batch of reads.
+     *
+     * The default implementation performs the reads with readAt() when the
+     * returned future is waited on. The requests must stay alive until then.
+     * @param requests Array of requests; bytesRead is filled in for each.
+     * @param count    Number of requests.
+     * @return Future that becomes ready when every request completed.
+     */
+    virtual std::future<void> readBatch(ReadRequest* requests, size_t count) const;
+};
+
+/**
+ * @brief Byte source reading a file with positional reads (pread).
+ *
+ * Only the ranges the parser asks for are read; nothing is mapped or cached.
+ */
+class FileByteSource : public ByteSource {
+public:
+    /**
+     * @brief Open a file.
+     * @param filepath Path to the file.
+     */
+    explicit FileByteSource(const std::string& filepath);
+    ~FileByteSource() override;
+
+    FileByteSource(const FileByteSource&) = delete;
+    FileByteSource& operator=(const FileByteSource&) = delete;
+
+    /**
+     * @brief Check if the file was opened successfully.
+     * @return true if open, false otherwise.
+     */
+    bool isOpen() const { return _fd >= 0; }
+
+    uint64_t size() const override { return _size; }
+    size_t readAt(uint64_t offset, void* buffer, size_t size) const override;
+
+private:
+    int _fd = -1;       ///< File descriptor
+    uint64_t _size = 0; ///< File size in bytes
+};
+
+/**
+ * @brief Byte source over a read-only memory mapping of a file.
+ *
+ * Provides views, so symbol tables are parsed straight from the page cache.
+ */
+class MmapByteSource : public ByteSource {
+public:
+    /**
+     * @brief Map a file.
+     * @param filepath Path to the file.
+     */
+    explicit MmapByteSource(const std::string& filepath);
+    ~MmapByteSource() override;
+
+    /**
+     * @brief Check if the file was mapped successfully.
+     * @return true if mapped, false otherwise.
+     */
+    bool isOpen() const;
+
+    uint64_t size() const override;
+    size_t readAt(uint64_t offset, void* buffer, size_t size) const override;
+    const char* view(uint64_t offset, size_t size) const override;
+
+private:
+    std::unique_ptr<detail::MappedFile> _file; ///< Mapping of the whole file
+};
+
+/**
+ * @brief Byte source over caller-owned memory.
+ *
+ * The memory is not copied and must outlive the source.
+ */
+class MemoryByteSource : public ByteSource {
+public:
+    /**
+     * @brief Wrap a memory region.
+     * @param data Pointer to the first byte.
+     * @param size Size of the region in bytes.
+     */
+    MemoryByteSource(const void* data, size_t size)
+        : _data(static_cast<const char*>(data)), _size(size) {}
+
+    uint64_t size() const override { return _size; }
+    size_t readAt(uint64_t offset, void* buffer, size_t size) const override;
+    const char* view(uint64_t offset, size_t size) const override;
+
+private:
+    const char* _data; ///< Start of the region
+    size_t _size;      ///< Size of the region in bytes
+};
+
+} // namespace minielf
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "minielf/MiniELF.hpp"
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace minielf {
+
+/**
+ * @brief Kind of file looked up by build ID.
+ */
+enum class DebugArtifact {
+    DebugInfo, ///< Separate debug information ("debuginfo")
+    Executable ///< The unstripped executable or library ("executable")
+};
+
+/**
+ * @brief Outcome of a lookup.
+ */
+enum class FetchStatus {
+    Found,    ///< The file is available
+    NotFound, ///< No server has the file
+    Error     ///< The lookup failed (network, I/O, invalid build ID)
+};
+
+/**
+ * @brief Result of DebugInfoClient::find().
+ */
+struct FetchResult {
+    FetchStatus status = FetchStatus::Error;
+    std::string path;  ///< Path of the cached file (FetchStatus::Found only)
+    std::string error; ///< Description of the failure (FetchStatus::Error only)
+};
+
+/**
+ * @brief Source of debug files, e.g. a debuginfod server.
+ *
+ * Implementations download one artifact into a file. DebugInfoClient calls
+ * fetch() at most once at a time per (build ID, artifact) and never for
+ * files already in its cache. fetch() may be called from several threads
+ * concurrently for different build IDs.
+ */
+class DebugInfoFetcher {
+public:
+    virtual ~DebugInfoFetcher() = default;
+
+    /**
+     * @brief Download an artifact.
+     * @param buildId     Build ID as lowercase hex.
+     * @param artifact    Kind of file to download.
+     * @param destination Path of the file to write.
+     * @param error       Receives a description of the failure on FetchStatus::Error.
+     * @return FetchStatus::Found if destination was written, FetchStatus::NotFound
+     *         if the file does not exist, FetchStatus::Error otherwise. An
+     *         exception is reported to every waiting caller as FetchStatus::Error.
+     */
+    virtual FetchStatus fetch(const std::string& buildId, DebugArtifact artifact,
+                              const std::string& destination, std::string& error) = 0;
+};
+
+/**
+ * @brief Fetcher speaking the debuginfod protocol (GET /buildid/ID/debuginfo) over plain HTTP.
+ *
+ * Servers are tried in order until one has the file. Only http:// URLs are
+ * supported; put a TLS-terminating proxy in front of https servers.
+ */
+class HttpFetcher : public DebugInfoFetcher {
+public:
+    /**
+     * @brief Create a fetcher for a list of servers.
+     * @param servers        Server URLs, e.g. "http://127.0.0.1:8002".
+     * @param timeoutSeconds Connect and receive timeout per request.
+     */
+    explicit HttpFetcher(std::vector<std::string> servers, int timeoutSeconds = 30);
+
+    /**
+     * @brief Create a fetcher for the servers listed in $DEBUGINFOD_URLS (space separated).
+     * @return Fetcher, or nullptr if the variable is unset or empty.
+     */
+    static std::shared_ptr<HttpFetcher> fromEnvironment();
+
+    FetchStatus fetch(const std::string& buildId, DebugArtifact artifact,
+                      const std::string& destination, std::string& error) override;
+
+private:
+    std::vector<std::string> _servers; ///< Server URLs in lookup order
+    int _timeoutSeconds;               ///< Per-request timeout
+};
+
+/**
+ * @brief Looks up debug files by build ID through a local content-addressed cache.
+ *
+ * Files are stored as CACHE/BUILDID/debuginfo (or executable), the layout
+ * used by debuginfod clients, and written atomically, so several processes
+ * can share one cache directory. Concurrent lookups of the same file are
+ * coalesced: one thread fetches, the others wait for its result. Misses are
+ * remembered with a marker file for a configurable time, so repeated lookups
+ * of unknown build IDs do not reach the servers; failed fetches (network
+ * errors) are not cached. All member functions may be called concurrently.
+ */
+class DebugInfoClient {
+public:
+    /**
+     * @brief Create a client.
+     * @param cacheDirectory Cache directory; created on first use.
+     * @param fetcher        Source of files missing from the cache (may be nullptr for cache-only use).
+     */
+    DebugInfoClient(std::string cacheDirectory, std::shared_ptr<DebugInfoFetcher> fetcher);
+
+    /**
+     * @brief Get the default cache directory.
+     * @return $DEBUGINFOD_CACHE_PATH, else $XDG_CACHE_HOME/debuginfod_client,
+     *         else $HOME/.cache/debuginfod_client.
+     */
+    static std::string defaultCacheDirectory();
+
+    /**
+     * @brief Set how long a miss is remembered.
+     * @param seconds Time in seconds; 0 disables negative caching. Default 600.
+     */
+    void setNegativeCacheTtl(int seconds);
+
+    /**
+     * @brief Look up a file by build ID.
+     * @param buildId  Build ID bytes, e.g. from MiniELF::getBuildId().
+     * @param artifact Kind of file.
+     * @return Lookup result; on FetchStatus::Found, path names the cached file.
+     */
+    FetchResult find(const std::vector<uint8_t>& buildId, DebugArtifact artifact = DebugArtifact::DebugInfo);
+
+    /**
+     * @brief Look up a file by build ID given as hex.
+     * @param buildId  Build ID as hex (case-insensitive).
+     * @param artifact Kind of file.
+     * @return Lookup result; on FetchStatus::Found, path names the cached file.
+     */
+    FetchResult find(const std::string& buildId, DebugArtifact artifact = DebugArtifact::DebugInfo);
+
+    /**
+     * @brief Look up the separate debug information of a parsed file.
+     * @param elf Parsed file; must have a GNU build ID.
+     * @return Lookup result.
+     */
+    FetchResult findDebugInfo(const MiniELF& elf);
+
+    /**
+     * @brief Get the number of times the fetcher was invoked.
+     * @return Number of fetches started by this client.
+     */
+    size_t getFetchCount() const;
+
+private:
+    /**
+     * @brief Fetch a file missing from the cache and store the outcome.
+     * @param buildId  Validated lowercase hex build ID.
+     * @param artifact Kind of file.
+     * @return Lookup result.
+     */
+    FetchResult fetchAndStore(const std::string& buildId, DebugArtifact artifact);
+
+    std::string _cacheDirectory;                 ///< Root of the cache
+    std::shared_ptr<DebugInfoFetcher> _fetcher;  ///< Source of missing files
+    std::atomic<int> _negativeTtl{600};          ///< Seconds a miss is remembered
+
+    mutable std::mutex _mutex; ///< Guards _inflight and _fetchCount
+    std::unordered_map<std::string, std::shared_future<FetchResult>> _inflight; ///< Running fetches by cache key
+    size_t _fetchCount = 0;    ///< Fetcher invocations
+};
+
+} // namespace minielf
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "minielf/MiniELF.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace minielf {
+
+/**
+ * @brief Search index over demangled C++ symbol names.
+ *
+ * Mangled (`_Z...`) symbol names are demangled in parallel, the results are
+ * stored back to back in a single arena, and entries are sorted by demangled
+ * name so exact and prefix lookups are binary searches returning contiguous
+ * spans. Symbols with plain C names are not indexed; look them up through
+ * MiniELF::getSymbolsByName().
+ *
+ * The index refers to the symbols of the MiniELF object it was built from,
+ * which must outlive it. Demangling requires the C++ ABI runtime
+ * (`<cxxabi.h>`); without it the index is empty.
+ */
+class DemangledIndex {
+public:
+    /**
+     * @brief Build the index over all mangled symbols of an ELF file.
+     * @param elf     Parsed ELF file.
+     * @param threads Number of worker threads (0 = hardware concurrency).
+     */
+    explicit DemangledIndex(const MiniELF& elf, unsigned threads = 0);
+
+    /**
+     * @brief Find symbols whose demangled name equals a string.
+     * @param name Demangled name, e.g. "myapp::Parser::run(int)".
+     * @return Span of matching symbols.
+     */
+    SymbolSpan findExact(std::string_view name) const;
+
+    /**
+     * @brief Find symbols whose demangled name starts with a prefix.
+     * @param prefix Demangled name prefix, e.g. "myapp::Parser::".
+     * @return Span of matching symbols, ordered by demangled name.
+     */
+    SymbolSpan findPrefix(std::string_view prefix) const;
+
+    /**
+     * @brief Find symbols by qualified name, ignoring return types and function parameters.
+     *
+     * Matches "myapp::Parser::run" against both the variable
+     * "myapp::Parser::run" and every overload "myapp::Parser::run(...)", and
+     * "ns::twice<int>" against the template instance "int ns::twice<int>(int)".
+     * The qualified names are located once, when the index is built, and kept
+     * in their own sorted order, so lookups are binary searches.
+     * @param qualifiedName Qualified name without return type or parameter list.
+     * @return Matching symbols, ordered by demangled name.
+     */
+    std::vector<const Symbol*> findQualified(std::string_view qualifiedName) const;
+
+    /**
+     * @brief Get the demangled name stored for a position of the index.
+     * @param position Position in the index, in [0, size()).
+     * @return Demangled name.
+     */
+    std::string_view getName(size_t position) const;
+
+    /**
+     * @brief Get the qualified name stored for a position of the index.
+     * @param position Position in the index, in [0, size()).
+     * @return Demangled name without return type and parameter list,
+     *         e.g. "ns::twice<int>" for "int ns::twice<int>(int)".
+     */
+    std::string_view getQualifiedName(size_t position) const;
+
+    /**
+     * @brief Get the number of indexed symbols.
+     * @return Number of entries.
+     */
+    size_t size() const { return _entries.size(); }
+
+    /**
+     * @brief Demangle a single symbol name.
+     * @param name Mangled name.
+     * @return Demangled name, or an empty string if name is not a valid mangled name.
+     */
+    static std::string demangle(const std::string& name);
+
+private:
+    /**
+     * @brief Location of a demangled name in the arena.
+     */
+    struct Entry {
+        uint64_t offset;          ///< Offset in _arena
+        uint32_t length;          ///< Length of the demangled name
+        uint32_t qualifiedStart;  ///< Offset of the qualified name in the demangled name
+        uint32_t qualifiedLength; ///< Length of the qualified name
+    };
+
+    std::string _arena;                  ///< All demangled names, back to back
+    std::vector<Entry> _entries;         ///< Names sorted by demangled form
+    std::vector<const Symbol*> _symbols; ///< Symbol of each entry (same order)
+    std::vector<uint32_t> _byQualified;  ///< Positions sorted by qualified name
+
+    /**
+     * @brief Span of entries in [first, last) positions.
+     */
+    SymbolSpan slice(size_t first, size_t last) const;
+
+    /**
+     * @brief Position of the first entry not less than a name.
+     */
+    size_t lowerBound(std::string_view name) const;
+};
+
+} // namespace minielf
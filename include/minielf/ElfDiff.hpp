@@ -0,0 +1,105 @@
+#pragma once
+
+#include "minielf/MiniELF.hpp"
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+namespace minielf {
+
+/**
+ * @brief Kind of difference between two builds.
+ */
+enum class DiffKind {
+    Added,   ///< Only in the new build
+    Removed, ///< Only in the old build
+    Resized, ///< In both builds with different sizes
+    Modified ///< Sections only: same size, different content hash
+};
+
+/**
+ * @brief One symbol difference.
+ */
+struct SymbolDiff {
+    DiffKind kind;
+    const Symbol* before; ///< Symbol in the old build (nullptr if added)
+    const Symbol* after;  ///< Symbol in the new build (nullptr if removed)
+};
+
+/**
+ * @brief One section difference.
+ */
+struct SectionDiff {
+    DiffKind kind;
+    const Section* before; ///< Section in the old build (nullptr if added)
+    const Section* after;  ///< Section in the new build (nullptr if removed)
+};
+
+/**
+ * @brief Totals of a diff.
+ */
+struct DiffStats {
+    size_t added = 0;      ///< Number of added entries
+    size_t removed = 0;    ///< Number of removed entries
+    size_t changed = 0;    ///< Number of resized or modified entries
+    int64_t sizeDelta = 0; ///< Total size change in bytes over all reported entries
+};
+
+/**
+ * @brief Compares the symbols and sections of two builds of a binary.
+ *
+ * Symbols are matched by name in one sorted merge over the name indexes of
+ * both files, so no symbol is copied or hashed and results are reported in
+ * name order as they are found. When several symbols share a name (e.g.
+ * static functions of different translation units) they are paired in
+ * symbol table order. Section and file symbols are ignored.
+ *
+ * Sections are matched by name the same way. If both sections carry content
+ * hashes (see ParseOptions::hashSections), equally sized sections with
+ * different contents are reported as DiffKind::Modified.
+ *
+ * Both MiniELF objects must outlive the diff and the reported pointers.
+ */
+class ElfDiff {
+public:
+    /**
+     * @brief Prepare a diff.
+     * @param before Old build.
+     * @param after  New build.
+     */
+    ElfDiff(const MiniELF& before, const MiniELF& after) : _before(before), _after(after) {}
+
+    /**
+     * @brief Report added, removed and resized symbols.
+     * @param callback Called for every difference, in name order.
+     * @return Totals of the reported differences.
+     */
+    DiffStats diffSymbols(const std::function<void(const SymbolDiff&)>& callback) const;
+
+    /**
+     * @brief Report added, removed and resized symbols of one type.
+     * @param type     Symbol type to compare (e.g. SymbolType::FUNC).
+     * @param callback Called for every difference, in name order.
+     * @return Totals of the reported differences.
+     */
+    DiffStats diffSymbols(SymbolType type, const std::function<void(const SymbolDiff&)>& callback) const;
+
+    /**
+     * @brief Report added, removed, resized and modified sections.
+     * @param callback Called for every difference, in name order.
+     * @return Totals of the reported differences.
+     */
+    DiffStats diffSections(const std::function<void(const SectionDiff&)>& callback) const;
+
+private:
+    /**
+     * @brief Merge the name indexes, reporting symbols accepted by a filter.
+     */
+    DiffStats mergeSymbols(const std::function<bool(const Symbol&)>& accept,
+                           const std::function<void(const SymbolDiff&)>& callback) const;
+
+    const MiniELF& _before; ///< Old build
+    const MiniELF& _after;  ///< New build
+};
+
+} // namespace minielf
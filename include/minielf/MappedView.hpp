@@ -0,0 +1,122 @@
+#pragma once
+
+#include "minielf/MiniELF.hpp"
+#include <optional>
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+namespace minielf {
+
+/**
+ * @brief Lookup handle for one mapping of an ELF file at a load bias.
+ *
+ * A view holds a reference to a parsed MiniELF and the bias (runtime address
+ * minus file address) of one mapping, e.g. a shared library in one process.
+ * Lookups take runtime addresses, translate them and query the shared
+ * indexes of the MiniELF, so any number of processes mapping the same file at
+ * different bases are served by one parsed copy; a view itself is a few
+ * words. Returned symbols and sections carry file addresses; use
+ * toRuntimeAddress() or getRuntimeAddress() to rebase them.
+ *
+ * Creating a view builds the address indexes of the MiniELF, so once the
+ * first view exists, lookups through any number of views only read shared
+ * state and may run concurrently. The MiniELF must outlive its views.
+ */
+class MappedView {
+public:
+    /**
+     * @brief Create a view with a known load bias.
+     * @param elf  Parsed ELF file.
+     * @param bias Runtime address minus file address (0 for non-PIE executables).
+     */
+    MappedView(const MiniELF& elf, uint64_t bias);
+
+    /**
+     * @brief Create a view from a memory mapping, e.g. a line of /proc/PID/maps.
+     *
+     * The bias is derived from the PT_LOAD segment containing the mapped file
+     * offset, so any mapping of the file (not only the first) can be used.
+     * @param elf        Parsed ELF file.
+     * @param start      Start address of the mapping.
+     * @param fileOffset File offset the mapping starts at.
+     * @return View over the mapping.
+     */
+    static MappedView fromMapping(const MiniELF& elf, uint64_t start, uint64_t fileOffset = 0);
+
+    /**
+     * @brief Get the underlying ELF file.
+     * @return Reference to the shared MiniELF.
+     */
+    const MiniELF& getELF() const { return *_elf; }
+
+    /**
+     * @brief Get the load bias.
+     * @return Runtime address minus file address.
+     */
+    uint64_t getBias() const { return _bias; }
+
+    /**
+     * @brief Check whether a runtime address lies in the mapped image.
+     * @param runtimeAddress Address in the mapping process.
+     * @return true if the address falls inside the loaded extent of the file.
+     */
+    bool contains(uint64_t runtimeAddress) const;
+
+    /**
+     * @brief Translate a runtime address to a file address.
+     * @param runtimeAddress Address in the mapping process.
+     * @return File address, or std::nullopt if the address lies outside the mapped image.
+     */
+    std::optional<uint64_t> toFileAddress(uint64_t runtimeAddress) const;
+
+    /**
+     * @brief Translate a file address to a runtime address.
+     * @param fileAddress Address as stored in the ELF file.
+     * @return Runtime address.
+     */
+    uint64_t toRuntimeAddress(uint64_t fileAddress) const { return fileAddress + _bias; }
+
+    /**
+     * @brief Get the runtime address of a symbol.
+     * @param symbol Symbol of the underlying ELF file.
+     * @return Runtime address of the symbol.
+     */
+    uint64_t getRuntimeAddress(const Symbol& symbol) const { return symbol.address + _bias; }
+
+    /**
+     * @brief Get the symbol covering a runtime address.
+     * @param runtimeAddress Address in the mapping process.
+     * @return Pointer to Symbol if found, nullptr otherwise.
+     */
+    const Symbol* getSymbolByAddress(uint64_t runtimeAddress) const;
+
+    /**
+     * @brief Find the nearest symbol at or before a runtime address.
+     * @param runtimeAddress Address in the mapping process.
+     * @return Pointer to nearest Symbol if found, nullptr otherwise.
+     */
+    const Symbol* getNearestSymbol(uint64_t runtimeAddress) const;
+
+    /**
+     * @brief Get the section containing a runtime address.
+     * @param runtimeAddress Address in the mapping process.
+     * @return Pointer to Section if found, nullptr otherwise.
+     */
+    const Section* getSectionByAddress(uint64_t runtimeAddress) const;
+
+    /**
+     * @brief Get the runtime address of a symbol by name.
+     * @param name Name of the symbol.
+     * @return Runtime address, or std::nullopt if no symbol has this name.
+     */
+    std::optional<uint64_t> getSymbolAddress(std::string_view name) const;
+
+private:
+    const MiniELF* _elf;  ///< Shared parsed file
+    uint64_t _bias;       ///< Runtime address minus file address
+    uint64_t _low = 0;    ///< Lowest loaded file address
+    uint64_t _high = 0;   ///< End of the highest loaded file address
+};
+
+} // namespace minielf
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "minielf/MiniELF.hpp"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+namespace minielf {
+
+namespace detail { class MappedFile; }
+
+/**
+ * @brief Member of a static (ar) archive.
+ */
+struct ArchiveMember {
+    std::string name;      ///< Member name (long names resolved)
+    uint64_t headerOffset; ///< Offset of the member header within the archive
+    uint64_t offset;       ///< Offset of the member data within the archive
+    uint64_t size;         ///< Size of the member data in bytes
+    uint32_t index = 0;    ///< Index of the member in the archive
+};
+
+/**
+ * @brief Entry of the archive symbol index.
+ */
+struct ArchiveSymbol {
+    std::string name;     ///< Symbol name
+    uint32_t memberIndex; ///< Index of the member defining the symbol
+};
+
+/**
+ * @brief Minimal static (ar) archive reader.
+ *
+ * Supports GNU archives (`/` and `/SYM64/` symbol index, `//` long name table)
+ * and BSD archives (`#1/<len>` names, `__.SYMDEF` symbol index). The archive is
+ * memory mapped and members are parsed in place, without extracting them.
+ */
+class MiniArchive {
+public:
+    /**
+     * @brief Construct a MiniArchive object and parse the archive file.
+     * @param filepath Path to the archive.
+     */
+    explicit MiniArchive(const std::string& filepath);
+    ~MiniArchive();
+
+    MiniArchive(const MiniArchive&) = delete;
+    MiniArchive& operator=(const MiniArchive&) = delete;
+
+    /**
+     * @brief Check if the archive was parsed successfully.
+     * @return true if valid, false otherwise.
+     */
+    bool isValid() const;
+
+    /**
+     * @brief Get the last error message.
+     * @return Last error message as a string.
+     */
+    std::string getLastError() const { return _lastError; }
+
+    /**
+     * @brief Get the list of archive members (symbol index and name tables excluded).
+     * @return Reference to the vector of members.
+     */
+    const std::vector<ArchiveMember>& getMembers() const;
+
+    /**
+     * @brief Get the archive symbol index.
+     * @return Reference to the vector of index entries (empty if the archive has none).
+     */
+    const std::vector<ArchiveSymbol>& getSymbolIndex() const;
+
+    /**
+     * @brief Get the parsed ELF object of a member, parsing it on first use.
+     *
+     * Safe to call concurrently; each member is parsed at most once.
+     * @param index Index of the member.
+     * @return Pointer to MiniELF (check isValid()), nullptr if index is out of range.
+     */
+    const MiniELF* getMemberELF(size_t index) const;
+
+    /**
+     * @brief Parse all members in parallel.
+     * @param threads Number of worker threads (0 = hardware concurrency).
+     */
+    void loadMembers(unsigned threads = 0) const;
+
+    /**
+     * @brief Find the member defining a symbol using the archive symbol index.
+     * @param name Name of the symbol.
+     * @return Pointer to ArchiveMember if found, nullptr otherwise.
+     */
+    const ArchiveMember* findMemberForSymbol(std::string_view name) const;
+
+private:
+    std::string _filepath;                             ///< Path to the archive
+    std::string _lastError;                            ///< Last error message
+    bool _valid = false;                               ///< Archive validity flag
+    std::unique_ptr<detail::MappedFile> _file;         ///< Mapping of the archive
+    std::vector<ArchiveMember> _members;               ///< Parsed members
+    std::vector<ArchiveSymbol> _symbolIndex;           ///< Archive symbol index
+    std::unordered_map<std::string_view, uint32_t> _memberBySymbol; ///< Symbol name (viewing the mapping) -> member index
+
+    mutable std::vector<std::unique_ptr<MiniELF>> _elves;  ///< Lazily parsed members
+    mutable std::unique_ptr<std::once_flag[]> _elfOnce;    ///< Per-member parse guards
+
+    /**
+     * @brief Parse the archive headers and symbol index.
+     */
+    void parse();
+
+    /**
+     * @brief Parse the GNU symbol index (`/` or `/SYM64/` member).
+     * @param data Start of the index member data.
+     * @param size Size of the index member data.
+     * @param wide true for the 64-bit `/SYM64/` variant.
+     */
+    void parseGnuSymbolIndex(const char* data, uint64_t size, bool wide);
+
+    /**
+     * @brief Parse the BSD symbol index (`__.SYMDEF` member).
+     * @param data Start of the index member data.
+     * @param size Size of the index member data.
+     * @param wide true for the 64-bit `__.SYMDEF_64` variant.
+     */
+    void parseBsdSymbolIndex(const char* data, uint64_t size, bool wide);
+
+    /**
+     * @brief Record an index entry referring to a member header offset.
+     * @param name         Symbol name, viewing the index member in the mapping.
+     * @param headerOffset Offset of the defining member's header.
+     */
+    void addIndexEntry(std::string_view name, uint64_t headerOffset);
+
+    /**
+     * @brief Set the last error message.
+     * @param msg Error message to set.
+     */
+    void setError(const std::string& msg) { _lastError = msg; }
+};
+
+} // namespace minielf
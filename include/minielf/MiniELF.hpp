@@ -1,13 +1,19 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
+#include <memory>
 #include <optional>
-#include <unordered_map>
+#include <utility>
 
 namespace minielf {
 
+class ByteSource;
+
 /**
  * @brief ELF64 program header structure.
  */
@@ -70,6 +76,14 @@ struct Elf64_Sym {
     uint64_t st_size;   ///< Symbol size
 };
 
+/**
+ * @brief ELF64 dynamic section entry structure.
+ */
+struct Elf64_Dyn {
+    int64_t  d_tag; ///< Entry type (DT_*)
+    uint64_t d_val; ///< Integer value or address (d_un)
+};
+
 /**
  * @brief Symbol type enumeration.
  */
@@ -92,6 +106,10 @@ struct Symbol {
     uint64_t address;   ///< Symbol address
     uint64_t size;      ///< Symbol size
     SymbolType type;    ///< Symbol type
+    /// Index of the section the symbol is defined in (st_shndx, resolved through
+    /// SHT_SYMTAB_SHNDX). Reserved indices are widened to 32 bits, e.g. SHN_ABS
+    /// becomes 0xfffffff1, so they never collide with real section indices.
+    uint32_t sectionIndex = 0;
 
     /**
      * @brief Check if the symbol is a function.
@@ -109,6 +127,135 @@ struct Section {
     std::string name;   ///< Section name
     uint64_t address;   ///< Section address
     uint64_t size;      ///< Section size
+    uint32_t index = 0; ///< Index of the section header
+    /// XXH64 (seed 0) of the section contents, if requested through
+    /// ParseOptions::hashSections; identical contents give identical hashes
+    /// regardless of file path or layout.
+    std::optional<uint64_t> hash;
+};
+
+/**
+ * @brief Lightweight non-owning view over a contiguous range of elements.
+ *
+ * Spans returned by MiniELF point into its internal lookup tables and stay
+ * valid for as long as the MiniELF object they came from.
+ */
+template <typename T>
+class Span {
+public:
+    Span() = default;
+    Span(const T* first, const T* last) : _first(first), _last(last) {}
+
+    const T* begin() const { return _first; }
+    const T* end() const { return _last; }
+    size_t size() const { return static_cast<size_t>(_last - _first); }
+    bool empty() const { return _first == _last; }
+    const T& operator[](size_t i) const { return _first[i]; }
+
+private:
+    const T* _first = nullptr;
+    const T* _last = nullptr;
+};
+
+/**
+ * @brief View over a range of symbol pointers.
+ */
+using SymbolSpan = Span<const Symbol*>;
+
+/**
+ * @brief View over the entries of an address index that intersect a window [lo, hi).
+ *
+ * Iterates in address order over pointers into the index. An entry
+ * [address, address + size) intersects the window if it overlaps it;
+ * zero-sized entries count as one byte. The entries starting before lo that
+ * reach into the window are collected when the view is created, through a
+ * max-tree over entry ends that visits only those entries; the entries
+ * starting inside the window are a span of the index. Iterators are valid as
+ * long as the view they came from and the index.
+ */
+template <typename T>
+class AddressRange {
+public:
+    /**
+     * @brief Forward iterator yielding `const T*`: the straddling entries, then the starting ones.
+     */
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = const T*;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T* const*;
+        using reference = const T* const&;
+
+        iterator() = default;
+        iterator(const T* const* it, const T* const* segmentEnd, const T* const* next)
+            : _it(it), _segmentEnd(segmentEnd), _next(next) { settle(); }
+
+        reference operator*() const { return *_it; }
+        iterator& operator++() { ++_it; settle(); return *this; }
+        iterator operator++(int) { iterator old = *this; ++*this; return old; }
+        bool operator==(const iterator& other) const { return _it == other._it; }
+        bool operator!=(const iterator& other) const { return _it != other._it; }
+
+    private:
+        // Move from the end of the straddling entries to the starting ones
+        void settle() {
+            if (_it == _segmentEnd) {
+                _it = _next;
+                _segmentEnd = nullptr;
+            }
+        }
+
+        const T* const* _it = nullptr;
+        const T* const* _segmentEnd = nullptr;
+        const T* const* _next = nullptr;
+    };
+
+    AddressRange() = default;
+
+    /**
+     * @brief Create a view.
+     * @param straddling Entries starting before lo that reach past it, in address order.
+     * @param first      First entry starting at or after lo.
+     * @param last       First entry starting at or after hi.
+     */
+    AddressRange(std::vector<const T*> straddling, const T* const* first, const T* const* last)
+        : _straddling(std::move(straddling)), _first(first), _last(last) {}
+
+    iterator begin() const {
+        return iterator(_straddling.data(), _straddling.data() + _straddling.size(), _first);
+    }
+    iterator end() const { return iterator(_last, nullptr, nullptr); }
+    bool empty() const { return _straddling.empty() && _first == _last; }
+
+    /**
+     * @brief Get the entries starting before the window that reach into it.
+     * @return Span over the straddling entries, in address order.
+     */
+    Span<const T*> straddling() const {
+        return Span<const T*>(_straddling.data(), _straddling.data() + _straddling.size());
+    }
+
+    /**
+     * @brief Get the entries starting inside the window.
+     * @return Span over the address index, excluding entries that straddle lo.
+     */
+    Span<const T*> starting() const { return Span<const T*>(_first, _last); }
+
+    /**
+     * @brief End address of an entry, counting zero-sized entries as one byte.
+     * @param entry Symbol or section.
+     * @return Exclusive end address (saturating).
+     */
+    static uint64_t entryEnd(const T& entry) {
+        const uint64_t size = entry.size ? entry.size : 1;
+        return size > UINT64_MAX - entry.address ? UINT64_MAX : entry.address + size;
+    }
+
+private:
+    std::vector<const T*> _straddling;
+    const T* const* _first = nullptr;
+    const T* const* _last = nullptr;
 };
 
 /**
@@ -122,8 +269,75 @@ struct ElfMetadata {
     uint32_t flags = 0;
 };
 
+/**
+ * @brief Layout of the bytes an ELF image is parsed from.
+ */
+enum class ImageLayout {
+    File,  ///< The ELF file as stored on disk; offsets are file offsets
+    Loaded ///< The image as mapped by the loader; offsets are relative to the load base
+};
+
+/**
+ * @brief Lookup indexes a MiniELF builds on first use; flags combine with |.
+ *
+ * Each index is built independently, so a workload pays only for the
+ * indexes its queries need, and can be freed with MiniELF::releaseIndexes().
+ */
+enum class LookupIndex : uint8_t {
+    Names     = 1, ///< Symbol name map: getSymbolByName(), getSymbolsByName(), getSymbolsSortedByName()
+    Addresses = 2, ///< Address orders: symbol and section address lookups, range queries, overlays
+    Sections  = 4, ///< Section name map and per-section symbol groups
+    Sizes     = 8, ///< Size orders: getLargestSymbols(), getSymbolsBySize()
+    Lookups   = 7, ///< Names, Addresses and Sections, the indexes background warming builds
+    All       = 15 ///< Every index
+};
+
+inline LookupIndex operator|(LookupIndex a, LookupIndex b) {
+    return static_cast<LookupIndex>(static_cast<uint8_t>(a) | static_cast<uint8_t>(b));
+}
+
+/**
+ * @brief When the lookup indexes (LookupIndex::Lookups) are built.
+ */
+enum class IndexWarming {
+    OnFirstUse, ///< By the first lookup that needs them
+    Wait,       ///< On a background thread right after parsing; lookups wait for it
+    Fallback    ///< On a background thread; point lookups scan linearly until it is done
+};
+
+/**
+ * @brief Optional work done while parsing.
+ */
+struct ParseOptions {
+    /// Names of sections whose contents are hashed into Section::hash, e.g.
+    /// {".text", ".rodata", ".dynsym"} to identify a library by content.
+    /// Only these sections are read; SHT_NOBITS sections are not hashed.
+    std::vector<std::string> hashSections;
+
+    /// Hash every section with contents in the file, whatever hashSections
+    /// names, e.g. to diff two builds section by section.
+    bool hashAllSections = false;
+
+    /// Build the lookup indexes in the background so that the first lookup
+    /// does not pay for them. With IndexWarming::Fallback, getSymbolByName(),
+    /// getSymbolByAddress(), getNearestSymbol(), getSectionByName() and
+    /// getSectionByAddress() answer by a linear scan until the indexes are
+    /// ready; queries returning spans over an index wait for it.
+    IndexWarming indexWarming = IndexWarming::OnFirstUse;
+};
+
 /**
  * @brief Minimal ELF file parser and accessor.
+ *
+ * A MiniELF is a handle to a parsed image that is shared by reference count:
+ * copying a handle is O(1) and the copy sees the same sections, symbols and
+ * lookup indexes, so any number of threads and components can hold the same
+ * binary without parsing or indexing it twice. Pointers and spans obtained
+ * through a handle stay valid as long as any handle shares the image. The
+ * shared image is never modified: addOverlaySymbols() and the overlay file
+ * loaders first give the handle its own copy of the image (indexes are then
+ * rebuilt for it), and releaseIndexes() only frees indexes of an image no
+ * other handle shares. A moved-from handle holds an empty, invalid image.
  */
 class MiniELF {
 public:
@@ -133,6 +347,87 @@ public:
      */
     explicit MiniELF(const std::string& filepath);
 
+    /**
+     * @brief Construct a MiniELF object and parse the ELF file with options.
+     * @param filepath Path to the ELF file.
+     * @param options  Additional parsing work, e.g. section hashing.
+     */
+    MiniELF(const std::string& filepath, const ParseOptions& options);
+
+    /**
+     * @brief Construct a MiniELF object and parse an ELF image held in memory.
+     *
+     * The buffer is only read during construction; all parsed data is copied,
+     * so it does not need to outlive the MiniELF object.
+     * @param data Pointer to the start of the ELF image.
+     * @param size Size of the image in bytes.
+     * @param name Name reported in diagnostics (e.g. "libfoo.a(bar.o)").
+     */
+    MiniELF(const void* data, size_t size, const std::string& name = "<memory>");
+
+    /**
+     * @brief Construct a MiniELF object and parse an ELF image from a byte source.
+     *
+     * Use this for images stored outside the local file system (blob stores,
+     * caches, encrypted containers). The source is only read during
+     * construction; all parsed data is copied.
+     * @param source Source of the image bytes.
+     * @param name   Name reported in diagnostics.
+     */
+    explicit MiniELF(const ByteSource& source, const std::string& name = "<source>");
+
+    /**
+     * @brief Construct a MiniELF object and parse an ELF image from a byte source with options.
+     * @param source  Source of the image bytes.
+     * @param name    Name reported in diagnostics.
+     * @param options Additional parsing work, e.g. section hashing.
+     */
+    MiniELF(const ByteSource& source, const std::string& name, const ParseOptions& options);
+
+    /**
+     * @brief Construct a MiniELF object and parse an ELF image with a given layout.
+     *
+     * With ImageLayout::Loaded the source holds the image as mapped into a
+     * process (e.g. read from another process's memory), where section
+     * headers are usually absent: sections stay empty and the dynamic
+     * symbols are reconstructed from PT_DYNAMIC and DT_HASH/DT_GNU_HASH.
+     * Symbol addresses are file addresses; use a MappedView to rebase them.
+     * @param source      Source of the image bytes.
+     * @param name        Name reported in diagnostics.
+     * @param layout      Layout of the source.
+     * @param loadAddress Runtime address of the first byte of a loaded image,
+     *                    used to recognise .dynamic pointers the loader
+     *                    relocated in place (0 if unknown).
+     */
+    MiniELF(const ByteSource& source, const std::string& name, ImageLayout layout,
+            uint64_t loadAddress = 0);
+
+    /**
+     * @brief Share the parsed image of another handle.
+     * @param other Handle to copy.
+     */
+    MiniELF(const MiniELF& other) = default;
+
+    /**
+     * @brief Take over the parsed image of another handle.
+     * @param other Handle to move from; left holding an empty, invalid image.
+     */
+    MiniELF(MiniELF&& other) noexcept;
+
+    /**
+     * @brief Share the parsed image of another handle.
+     * @param other Handle to copy.
+     * @return Reference to this handle.
+     */
+    MiniELF& operator=(const MiniELF& other) = default;
+
+    /**
+     * @brief Take over the parsed image of another handle.
+     * @param other Handle to move from; left holding an empty, invalid image.
+     * @return Reference to this handle.
+     */
+    MiniELF& operator=(MiniELF&& other) noexcept;
+
     /**
      * @brief Check if the ELF file was parsed successfully.
      * @return true if valid, false otherwise.
@@ -141,15 +436,15 @@ public:
 
     /**
      * @brief Get the list of ELF sections.
-     * @return Vector of Section objects.
+     * @return Reference to the vector of Section objects, in section header order.
      */
-    std::vector<Section> getSections() const;
+    const std::vector<Section>& getSections() const;
 
     /**
      * @brief Get the list of ELF symbols.
-     * @return Vector of Symbol objects.
+     * @return Reference to the vector of Symbol objects, in symbol table order.
      */
-    std::vector<Symbol> getSymbols() const;
+    const std::vector<Symbol>& getSymbols() const;
 
     /**
      * @brief Find a symbol by its address.
@@ -160,10 +455,22 @@ public:
 
     /**
      * @brief Find a symbol by its name.
+     *
+     * When several symbols share the name, the last one in symbol table order
+     * is returned; since local symbols precede global ones in the table, this
+     * is the global definition if there is one. Use getSymbolsByName() to get
+     * every match.
      * @param name Name of the symbol to search for.
      * @return Pointer to Symbol if found, nullptr otherwise.
      */
-    const Symbol* getSymbolByName(const std::string& name) const;
+    const Symbol* getSymbolByName(std::string_view name) const;
+
+    /**
+     * @brief Find all symbols with a given name.
+     * @param name Name of the symbols to search for.
+     * @return Span of matching symbols in symbol table order (empty if none).
+     */
+    SymbolSpan getSymbolsByName(std::string_view name) const;
 
     /**
      * @brief Find the nearest symbol with address <= given address.
@@ -172,6 +479,161 @@ public:
      */
     const Symbol* getNearestSymbol(uint64_t address) const;
 
+    /**
+     * @brief Get all symbols ordered by address.
+     * @return Span over the address index, in increasing address order.
+     */
+    SymbolSpan getSymbolsSortedByAddress() const;
+
+    /**
+     * @brief Get all named symbols ordered by name.
+     * @return Span over the name index; symbols sharing a name are contiguous
+     *         and keep symbol table order.
+     */
+    SymbolSpan getSymbolsSortedByName() const;
+
+    /**
+     * @brief Get the symbols intersecting an address window, in address order.
+     *
+     * Costs O(log n + k) for k symbols in the window, however long the
+     * symbols enclosing it; overlay symbols are included. Empty for
+     * relocatable objects.
+     *
+     * @param lo First address of the window.
+     * @param hi End of the window (exclusive).
+     * @return View over the address index.
+     */
+    AddressRange<Symbol> getSymbolsInRange(uint64_t lo, uint64_t hi) const;
+
+    /**
+     * @brief Merge external symbols (e.g. registered by a JIT) into the address index.
+     *
+     * The batch is sorted and merged into the existing address index in linear
+     * time, so appends never rebuild it. Among symbols starting at the same
+     * address the one with the highest priority wins address lookups; on equal
+     * priority the later registration wins. ELF symbols have priority 0.
+     * Overlay symbols are only visible to the address-based lookups and
+     * getSymbolsSortedByAddress(), not to name, size or section queries.
+     * A sectionIndex of 0 is replaced by SHN_ABS (0xfffffff1), since overlay
+     * symbols are defined but not backed by an ELF section. If other handles
+     * share the image, this handle first gets its own copy of it.
+     * @param symbols  Symbols to add.
+     * @param priority Priority of the batch.
+     */
+    void addOverlaySymbols(std::vector<Symbol> symbols, int priority = 1);
+
+    /**
+     * @brief Merge a perf map file ("START SIZE name" lines, hex) into the address index.
+     *
+     * The number of bytes consumed is remembered per path, so calling this
+     * again on a growing file only ingests the newly appended complete lines.
+     * Malformed lines are skipped.
+     * @param path     Path of the map file, e.g. /tmp/perf-PID.map.
+     * @param priority Priority of the symbols, see addOverlaySymbols().
+     * @return true if the file could be read, false otherwise.
+     */
+    bool loadPerfMap(const std::string& path, int priority = 1);
+
+    /**
+     * @brief Hash the contents of named sections into Section::hash after parsing.
+     *
+     * Lets a tool pay for hashing only when a command needs it, instead of
+     * through ParseOptions::hashSections for every parse. Only the named
+     * sections not hashed yet are read; SHT_NOBITS sections are not hashed.
+     * Copies the image first if other handles share it.
+     * @param source Source of the bytes the file was parsed from, e.g. a
+     *               FileByteSource reopened through getFilePath().
+     * @param names  Names of the sections to hash.
+     * @return false if the file is invalid or the source is not the size of
+     *         the parsed file, true otherwise.
+     */
+    bool hashSections(const ByteSource& source, const std::vector<std::string>& names);
+
+    /**
+     * @brief Merge a plain text symbol list ("ADDRESS SIZE TYPE name" lines, hex)
+     * into the address index, as written by SymbolExporter with ExportFormat::SymbolList.
+     *
+     * Appended lines are ingested incrementally like loadPerfMap().
+     * @param path     Path of the symbol list.
+     * @param priority Priority of the symbols, see addOverlaySymbols().
+     * @return true if the file could be read, false otherwise.
+     */
+    bool loadSymbolList(const std::string& path, int priority = 1);
+
+    /**
+     * @brief Get the number of overlay symbols merged so far.
+     * @return Number of symbols added through the overlay functions.
+     */
+    size_t getOverlaySymbolCount() const;
+
+    /**
+     * @brief Check whether the ELF file is a relocatable object (ET_REL).
+     *
+     * In relocatable objects symbol values are offsets within their section and
+     * all section addresses are zero, so the address-based lookups return nullptr;
+     * use the section-relative lookups instead.
+     * @return true if the file is a relocatable object, false otherwise.
+     */
+    bool isRelocatable() const;
+
+    /**
+     * @brief Get all symbols defined in a section, ordered by offset.
+     * @param sectionIndex Index of the section header.
+     * @return Span of symbols (empty if the index is out of range).
+     */
+    SymbolSpan getSymbolsInSection(uint32_t sectionIndex) const;
+
+    /**
+     * @brief Find a symbol covering an offset within a section.
+     *
+     * For relocatable objects the offset is the symbol value itself; for linked
+     * files it is the address relative to the start of the section.
+     * @param sectionIndex Index of the section header.
+     * @param offset       Offset within the section.
+     * @return Pointer to Symbol if found, nullptr otherwise.
+     */
+    const Symbol* getSymbolBySectionOffset(uint32_t sectionIndex, uint64_t offset) const;
+
+    /**
+     * @brief Find the nearest symbol with offset <= given offset within a section.
+     * @param sectionIndex Index of the section header.
+     * @param offset       Offset within the section.
+     * @return Pointer to nearest Symbol if found, nullptr otherwise.
+     */
+    const Symbol* getNearestSymbolInSection(uint32_t sectionIndex, uint64_t offset) const;
+
+    /**
+     * @brief Get the largest symbols, largest first.
+     * @param count Maximum number of symbols to return.
+     * @return Span of at most count symbols ordered by decreasing size.
+     */
+    SymbolSpan getLargestSymbols(size_t count) const;
+
+    /**
+     * @brief Get the largest symbols of a given type, largest first.
+     * @param count Maximum number of symbols to return.
+     * @param type  Symbol type to select (e.g. SymbolType::FUNC).
+     * @return Span of at most count symbols ordered by decreasing size.
+     */
+    SymbolSpan getLargestSymbols(size_t count, SymbolType type) const;
+
+    /**
+     * @brief Get all symbols whose size lies in [minSize, maxSize], largest first.
+     * @param minSize Minimum size in bytes (inclusive).
+     * @param maxSize Maximum size in bytes (inclusive).
+     * @return Span of symbols ordered by decreasing size.
+     */
+    SymbolSpan getSymbolsBySize(uint64_t minSize, uint64_t maxSize) const;
+
+    /**
+     * @brief Get all symbols of a given type whose size lies in [minSize, maxSize].
+     * @param minSize Minimum size in bytes (inclusive).
+     * @param maxSize Maximum size in bytes (inclusive).
+     * @param type    Symbol type to select.
+     * @return Span of symbols ordered by decreasing size.
+     */
+    SymbolSpan getSymbolsBySize(uint64_t minSize, uint64_t maxSize, SymbolType type) const;
+
     /**
      * @brief Get a section by its address.
      * @param addr Address of the section to find.
@@ -179,12 +641,22 @@ public:
      */
     const Section* getSectionByAddress(uint64_t addr) const;
 
+    /**
+     * @brief Get the sections intersecting an address window, in address order.
+     *
+     * Costs O(log n + k) for k sections in the window.
+     * @param lo First address of the window.
+     * @param hi End of the window (exclusive).
+     * @return View over the section address index; empty for relocatable objects.
+     */
+    AddressRange<Section> getSectionsInRange(uint64_t lo, uint64_t hi) const;
+
     /**
      * @brief Get a section by its name.
      * @param name Name of the section to search for.
      * @return Pointer to Section if found, nullptr otherwise.
      */
-    const Section* getSectionByName(const std::string& name) const;
+    const Section* getSectionByName(std::string_view name) const;
 
     /**
      * @brief Get the metadata of the ELF file.
@@ -208,10 +680,19 @@ public:
 
     /**
      * @brief Get the raw ELF section headers (Elf64_Shdr).
+     *
+     * Contains every section header, also for files using extended numbering
+     * where the raw header's e_shnum is 0.
      * @return Reference to the vector of section header structures.
      */
     const std::vector<Elf64_Shdr>& getSectionHeaders() const;
 
+    /**
+     * @brief Get the path (or name, for in-memory images) the ELF file was opened with.
+     * @return Reference to the path string.
+     */
+    const std::string& getFilePath() const;
+
     /**
      * @brief Get the size of the ELF file in bytes.
      * @return File size in bytes, or 0 if file is not accessible.
@@ -224,12 +705,31 @@ public:
      */
     const std::vector<Elf64_Phdr>& getProgramHeaders() const;
 
+    /**
+     * @brief Get the GNU build ID (NT_GNU_BUILD_ID note, usually .note.gnu.build-id).
+     * @return Reference to the build ID bytes (empty if the file has none).
+     */
+    const std::vector<uint8_t>& getBuildId() const;
+
     /**
      * @brief Get the raw section header string table.
      * @return Reference to the vector containing the raw section string table.
      */
     const std::vector<char>& getSectionStringTableRaw() const;
 
+    /**
+     * @brief Get the raw string table the symbol names were read from (.strtab or .dynstr).
+     * @return Reference to the vector containing the raw symbol string table.
+     */
+    const std::vector<char>& getSymbolStringTableRaw() const;
+
+    /**
+     * @brief Get the raw name offsets (st_name) of all symbols.
+     * @return Reference to the vector of offsets into the symbol string table,
+     *         indexed like getSymbols().
+     */
+    const std::vector<uint32_t>& getSymbolNameOffsets() const;
+
     /**
      * @brief Get the stage at which parsing failed.
      * @return ParseStage enum value indicating the failure stage.
@@ -253,25 +753,100 @@ public:
      */
     void enableUnsafeAccess();
 
+    /**
+     * @brief Check whether lookup indexes have been built.
+     * @param which Indexes to check.
+     * @return true if all of them are built, false while any is pending.
+     */
+    bool areIndexesReady(LookupIndex which = LookupIndex::Lookups) const;
+
+    /**
+     * @brief Build lookup indexes now, or wait for the background build.
+     * @param which Indexes to build.
+     */
+    void waitForIndexes(LookupIndex which = LookupIndex::Lookups) const;
+
+    /**
+     * @brief Free lookup indexes; they are rebuilt on their next use.
+     *
+     * Spans and ranges obtained from a released index become invalid. Must not
+     * run concurrently with lookups. Does nothing while other handles share the
+     * image, since they may be using the indexes.
+     * @param which Indexes to free.
+     */
+    void releaseIndexes(LookupIndex which = LookupIndex::All);
+
 private:
-    bool _unsafeAccessEnabled = false;        ///< Flag to allow unsafe access to raw data
+    struct Image;
 
-    std::string _filepath;                    ///< Path to the ELF file
-    bool _valid = false;                      ///< ELF file validity flag
-    std::vector<Section> _sections;           ///< Parsed sections
-    std::vector<Symbol> _symbols;             ///< Parsed symbols
-    Elf64_Ehdr _elfHeader{};                  ///< ELF header structure
-    std::vector<Elf64_Shdr> _sectionHeaders;  ///< Section headers
-    std::vector<Elf64_Phdr> _programHeaders;  ///< Program headers
-    std::vector<char> _sectionStringTableRaw; ///< Raw section string table
+    std::shared_ptr<Image> _image;            ///< Parsed image, shared by copies
+    bool _unsafeAccessEnabled = false;        ///< Flag to allow unsafe access to raw data
     std::string _lastError;                   ///< Last error message
-    
-    ParseStage _failureStage = ParseStage::Header; ///< Stage of failure during parsing
 
     /**
-     * @brief Parse the ELF file and populate sections and symbols.
+     * @brief Get an empty image for moved-from handles.
+     * @return Shared pointer to the empty image.
+     */
+    static std::shared_ptr<Image> emptyImage();
+
+    /**
+     * @brief Get the image for modification, copying it first if other handles share it.
+     * @return Reference to an image owned by this handle only.
+     */
+    Image& mutableImage();
+
+    /**
+     * @brief Parse an image into the image of this handle.
+     *
+     * The address indexes are not built here: they are built lazily on first
+     * use (or by the warmer) and live in the shared image, so every handle
+     * sharing it reuses them.
+     * @param source      Source of the image bytes.
+     * @param layout      Layout of the source.
+     * @param loadAddress Runtime address of a loaded image (0 if unknown).
      */
-    void parse();
+    void init(const ByteSource& source, ImageLayout layout = ImageLayout::File, uint64_t loadAddress = 0);
+
+    /**
+     * @brief Hash the contents of the sections selected by the options into Section::hash.
+     * @param source  Source of the image bytes.
+     * @param options Parse options naming the sections.
+     */
+    void computeSectionHashes(const ByteSource& source, const ParseOptions& options);
+
+    /**
+     * @brief Start building the lookup indexes in the background if requested.
+     * @param warming When to build the indexes.
+     */
+    void startIndexWarming(IndexWarming warming);
+
+    /**
+     * @brief Check whether point lookups should scan linearly for now.
+     * @param index Index the lookup needs.
+     * @return true while a Fallback background build of that index is pending.
+     */
+    bool useFallbackLookups(LookupIndex index) const;
+
+    /**
+     * @brief Read and validate the ELF header.
+     * @param source Source of the image bytes.
+     * @param ehdr   Receives the header.
+     * @return true if the header describes a supported ELF image, false otherwise.
+     */
+    bool readHeader(const ByteSource& source, Elf64_Ehdr& ehdr);
+
+    /**
+     * @brief Parse an image as mapped by the loader, reconstructing dynamic symbols.
+     * @param source      Source of the image bytes, offset 0 being the load base.
+     * @param loadAddress Runtime address of the first byte of the source (0 if unknown).
+     */
+    void parseLoaded(const ByteSource& source, uint64_t loadAddress);
+
+    /**
+     * @brief Parse the ELF image and populate sections and symbols.
+     * @param source Source of the image bytes.
+     */
+    void parse(const ByteSource& source);
 
     /**
      * @brief Set the last error message.
@@ -281,25 +856,46 @@ private:
 
     /**
      * @brief Parse symbols from the ELF file.
-     * @param file      Input file stream (already open).
-     * @param shstrtab  Section header string table.
+     * @param source    Source of the image bytes.
      * @param shdrs     Section headers.
-     * @param ehdr      ELF header.
+     * @param shstrndx  Index of the section header string table.
      */
-    void parseSymbols(std::ifstream& file, const std::vector<char>& shstrtab,
-                      const std::vector<Elf64_Shdr>& shdrs, const Elf64_Ehdr& ehdr);
+    void parseSymbols(const ByteSource& source, const std::vector<Elf64_Shdr>& shdrs,
+                      uint32_t shstrndx);
 
-    mutable std::unordered_map<std::string, const Symbol*> _symbolByName;
-    mutable std::vector<const Symbol*> _symbolsSortedByAddr;
-    mutable std::vector<const Section*> _sectionsSortedByAddr;
-    mutable std::unordered_map<std::string, const Section*> _sectionByName;
-    mutable bool _lookupBuilt = false;
+    /**
+     * @brief Decode a symbol table and append its symbols.
+     * @param table   First symbol table entry.
+     * @param count   Number of entries.
+     * @param entsize Size of one entry in bytes.
+     * @param strtab  Symbol string table; becomes the raw symbol string table.
+     * @param shndx   Extended section indices (SHT_SYMTAB_SHNDX), may be empty.
+     */
+    void addSymbols(const char* table, size_t count, size_t entsize, std::vector<char> strtab,
+                    const std::vector<uint32_t>& shndx);
+
+    /**
+     * @brief Ingest the unread complete lines of an overlay text file.
+     * @param path     Path of the file.
+     * @param priority Priority of the symbols.
+     * @param withType Whether lines carry a type column (symbol list format).
+     * @return true if the file could be read, false otherwise.
+     */
+    bool loadOverlayFile(const std::string& path, int priority, bool withType);
+
+    /**
+     * @brief Read the GNU build ID from the SHT_NOTE sections, if any.
+     * @param source Source of the image bytes.
+     * @param shdrs  Section headers.
+     */
+    void parseBuildId(const ByteSource& source, const std::vector<Elf64_Shdr>& shdrs);
 
     /**
-     * @brief Build lookups for symbols and sections.
-     * This is called lazily to avoid unnecessary overhead if not needed.
+     * @brief Get the part of the type-grouped size index holding one symbol type.
+     * @param type Symbol type.
+     * @return Span of symbols of that type, largest first.
      */
-    void buildLookups() const;
+    SymbolSpan symbolsOfType(SymbolType type) const;
 };
 
 } // namespace minielf
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "minielf/MiniELF.hpp"
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+namespace minielf {
+
+/**
+ * @brief Index-free symbol name search over the raw symbol string table.
+ *
+ * Scans the bytes of .strtab/.dynstr directly, split across threads at string
+ * boundaries, with a vectorized (SSE2 where available) substring search, and
+ * maps hits back to symbols through a sorted array of st_name offsets. No
+ * per-symbol strings are built, which makes it the cheapest option for
+ * one-off queries; use NgramIndex for repeated interactive searches.
+ *
+ * Because the mapping goes through st_name offsets, symbols whose names are
+ * tail-merged into a longer string are found as well.
+ *
+ * The scanner refers to the MiniELF object it was built from, which must
+ * outlive it.
+ */
+class NameScanner {
+public:
+    /**
+     * @brief Prepare a scanner for the symbols of an ELF file.
+     * @param elf     Parsed ELF file.
+     * @param threads Number of worker threads (0 = hardware concurrency).
+     */
+    explicit NameScanner(const MiniELF& elf, unsigned threads = 0);
+
+    /**
+     * @brief Find symbols whose name contains a substring.
+     * @param needle Substring to search for (must not be empty).
+     * @return Indices into MiniELF::getSymbols(), in increasing order.
+     */
+    std::vector<uint32_t> findContaining(std::string_view needle) const;
+
+    /**
+     * @brief Find symbols whose name matches a regular expression (std::regex_search).
+     *
+     * A literal that every match must contain is extracted from the pattern
+     * and used as a substring prefilter; the regex only runs on symbols
+     * passing it.
+     * @param pattern Regular expression (ECMAScript syntax by default).
+     * @param flags   Regex syntax options.
+     * @return Indices into MiniELF::getSymbols(), in increasing order.
+     * @throws std::regex_error if the pattern is invalid.
+     */
+    std::vector<uint32_t> findMatching(const std::string& pattern,
+        std::regex_constants::syntax_option_type flags = std::regex_constants::ECMAScript) const;
+
+    /**
+     * @brief Extract the longest literal every match of an ECMAScript pattern must contain.
+     * @param pattern Regular expression.
+     * @return Required literal, or an empty string if none can be derived safely.
+     */
+    static std::string requiredLiteral(const std::string& pattern);
+
+private:
+    const std::vector<char>& _strtab;      ///< Raw symbol string table
+    const std::vector<uint32_t>& _nameOffsets; ///< st_name of each symbol
+    std::vector<uint64_t> _sortedOffsets;  ///< (st_name << 32 | symbol index), sorted
+    std::vector<size_t> _chunks;           ///< Chunk boundaries in _strtab (string aligned)
+    unsigned _threads;                     ///< Number of worker threads
+};
+
+} // namespace minielf
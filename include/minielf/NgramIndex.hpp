@@ -0,0 +1,99 @@
+#pragma once
+
+#include "minielf/MiniELF.hpp"
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace minielf {
+
+/**
+ * @brief Result of a symbol name search.
+ */
+struct SymbolMatch {
+    const Symbol* symbol;  ///< Matching symbol
+    uint32_t distance;     ///< Edit distance of the best matching substring (0 = exact)
+};
+
+/**
+ * @brief Trigram inverted index over symbol names.
+ *
+ * Every symbol name is split into overlapping 3-byte grams; each gram maps to
+ * the delta + varint compressed list of symbols containing it. Substring
+ * queries intersect the posting lists of the pattern's grams, and fuzzy
+ * queries use the q-gram count filter before verifying candidates, so only a
+ * small fraction of the symbol table is ever compared against the pattern.
+ *
+ * The index refers to the symbols of the MiniELF object it was built from,
+ * which must outlive it.
+ */
+class NgramIndex {
+public:
+    /**
+     * @brief Build the index over all named symbols of an ELF file.
+     * @param elf     Parsed ELF file.
+     * @param threads Number of worker threads (0 = hardware concurrency).
+     */
+    explicit NgramIndex(const MiniELF& elf, unsigned threads = 0);
+
+    /**
+     * @brief Find symbols whose name contains a substring.
+     *
+     * Results are ranked: exact name matches first, then prefix matches, then
+     * shorter names. Patterns shorter than three bytes fall back to a scan.
+     * @param pattern Substring to search for.
+     * @param limit   Maximum number of results.
+     * @return Matching symbols, best first (distance is always 0).
+     */
+    std::vector<SymbolMatch> findSubstring(const std::string& pattern, size_t limit = 100) const;
+
+    /**
+     * @brief Find symbols containing a substring within a bounded edit distance.
+     *
+     * Results are ranked by distance, then like findSubstring().
+     * @param pattern     Substring to search for.
+     * @param maxDistance Maximum number of insertions, deletions or substitutions.
+     * @param limit       Maximum number of results.
+     * @return Matching symbols, best first.
+     */
+    std::vector<SymbolMatch> findFuzzy(const std::string& pattern, uint32_t maxDistance,
+                                       size_t limit = 100) const;
+
+    /**
+     * @brief Get the number of distinct trigrams in the index.
+     * @return Number of posting lists.
+     */
+    size_t getTrigramCount() const { return _keys.size(); }
+
+    /**
+     * @brief Get the size of the compressed posting lists.
+     * @return Size in bytes.
+     */
+    size_t getPostingsSize() const { return _postings.size(); }
+
+private:
+    const std::vector<Symbol>& _symbols; ///< Symbols of the indexed ELF file
+    std::vector<uint32_t> _keys;         ///< Sorted trigram keys
+    std::vector<uint32_t> _counts;       ///< Number of symbols per trigram
+    std::vector<uint64_t> _offsets;      ///< Start of each posting list in _postings (+ end sentinel)
+    std::vector<uint8_t> _postings;      ///< Delta + varint encoded symbol indices
+
+    /**
+     * @brief Decode the posting list of a trigram.
+     * @param key Trigram key.
+     * @param out Receives the symbol indices in increasing order.
+     * @return false if the trigram does not occur.
+     */
+    bool decode(uint32_t key, std::vector<uint32_t>& out) const;
+
+    /**
+     * @brief Sort matches by rank and truncate them to limit.
+     * @param matches Matches to rank.
+     * @param pattern Query pattern.
+     * @param limit   Maximum number of results.
+     */
+    void rank(std::vector<SymbolMatch>& matches, const std::string& pattern, size_t limit) const;
+};
+
+} // namespace minielf
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "minielf/ByteSource.hpp"
+#include "minielf/MiniELF.hpp"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+namespace minielf {
+
+/**
+ * @brief Byte source reading another process's memory with process_vm_readv.
+ *
+ * Offset 0 of the source is a runtime address in the target process, usually
+ * the load base of a module. Reading requires ptrace access to the target
+ * (same user and a permissive Yama ptrace_scope, or CAP_SYS_PTRACE). Unmapped
+ * gaps between segments produce short reads.
+ */
+class ProcessMemorySource : public ByteSource {
+public:
+    /**
+     * @brief Create a source over a range of a process's address space.
+     * @param pid     Target process ID.
+     * @param address Runtime address of offset 0.
+     * @param size    Size of the range in bytes.
+     */
+    ProcessMemorySource(int pid, uint64_t address, uint64_t size)
+        : _pid(pid), _address(address), _size(size) {}
+
+    /**
+     * @brief Get the runtime address of offset 0.
+     * @return Address in the target process.
+     */
+    uint64_t address() const { return _address; }
+
+    uint64_t size() const override { return _size; }
+    size_t readAt(uint64_t offset, void* buffer, size_t size) const override;
+
+    /**
+     * @brief Perform a batch of reads with as few process_vm_readv calls as possible.
+     *
+     * Up to IOV_MAX requests go into one system call. Requests the kernel
+     * only partially transferred are retried one by one. The reads are done
+     * when the returned future is waited on.
+     * @param requests Array of requests; bytesRead is filled in for each.
+     * @param count    Number of requests.
+     * @return Future that becomes ready when every request completed.
+     */
+    std::future<void> readBatch(ReadRequest* requests, size_t count) const override;
+
+private:
+    int _pid;          ///< Target process ID
+    uint64_t _address; ///< Runtime address of offset 0
+    uint64_t _size;    ///< Size of the range in bytes
+};
+
+/**
+ * @brief One line of /proc/PID/maps.
+ */
+struct ProcessMapping {
+    uint64_t start = 0;   ///< Start address
+    uint64_t end = 0;     ///< End address (exclusive)
+    uint64_t offset = 0;  ///< File offset of the start address
+    uint64_t inode = 0;   ///< Inode of the backing file (0 for anonymous memory)
+    std::string perms;    ///< Permissions, e.g. "r-xp"
+    std::string path;     ///< Backing path, "[vdso]" etc.; may end in " (deleted)"
+};
+
+/**
+ * @brief Parses ELF images straight from the memory of running processes.
+ *
+ * Useful for binaries that no longer exist on disk (upgraded in place) or
+ * never did (memfd-backed JIT images). Images are parsed with
+ * ImageLayout::Loaded, so symbols come from the in-memory dynamic symbol
+ * table. Results are cached per (pid, load address); failed parses are cached
+ * too, so a process that cannot be read is not retried until invalidate().
+ * All member functions may be called concurrently.
+ */
+class ProcessImageCache {
+public:
+    /**
+     * @brief Read the memory mappings of a process.
+     * @param pid Target process ID.
+     * @return Mappings in address order (empty if /proc/PID/maps cannot be read).
+     */
+    static std::vector<ProcessMapping> readMappings(int pid);
+
+    /**
+     * @brief Get the image whose ELF header is mapped at an address, parsing it on first use.
+     *
+     * The extent of the image is taken from its PT_LOAD segments.
+     * @param pid         Target process ID.
+     * @param loadAddress Runtime address of the ELF header, i.e. the start of
+     *                    the mapping at file offset 0.
+     * @return Parsed image; check isValid() and getLastError() for failures.
+     */
+    std::shared_ptr<const MiniELF> get(int pid, uint64_t loadAddress);
+
+    /**
+     * @brief Get the image a mapping belongs to.
+     *
+     * Finds the mapping of the same file at offset 0 in the process's
+     * mappings and loads the image from there.
+     * @param pid     Target process ID.
+     * @param mapping Any mapping of the image, e.g. the executable segment.
+     * @return Parsed image, or nullptr if no mapping at file offset 0 was found.
+     */
+    std::shared_ptr<const MiniELF> get(int pid, const ProcessMapping& mapping);
+
+    /**
+     * @brief Find the address the vDSO is mapped at in a process.
+     *
+     * Uses getauxval(AT_SYSINFO_EHDR) for the calling process and
+     * /proc/PID/auxv for others.
+     * @param pid Target process ID.
+     * @return Address of the vDSO ELF header, or 0 if the process has no vDSO
+     *         or its auxiliary vector cannot be read.
+     */
+    static uint64_t findVdso(int pid);
+
+    /**
+     * @brief Get the vDSO image of a process (clock_gettime, gettimeofday, ...).
+     *
+     * Every process on a kernel maps the same vDSO, so the image is parsed
+     * once per kernel build and ELF class and shared; only its address
+     * differs between processes. Use
+     * MappedView::fromMapping(*vdso, findVdso(pid)) to resolve runtime
+     * addresses. vDSO images are not dropped by invalidate().
+     * @param pid Target process ID.
+     * @return Parsed vDSO, or nullptr if the process has none.
+     */
+    std::shared_ptr<const MiniELF> getVdso(int pid);
+
+    /**
+     * @brief Drop the cached images of a process, e.g. after it exited or exec'd.
+     * @param pid Target process ID.
+     */
+    void invalidate(int pid);
+
+    /**
+     * @brief Get the number of cached process images.
+     * @return Number of (pid, load address) entries, not counting vDSO images.
+     */
+    size_t size() const;
+
+private:
+    mutable std::mutex _mutex; ///< Guards _images and _vdsoImages
+    std::map<std::pair<int, uint64_t>, std::shared_ptr<const MiniELF>> _images; ///< (pid, load address) -> image
+    std::map<std::string, std::shared_ptr<const MiniELF>> _vdsoImages;          ///< Kernel build and class -> vDSO
+};
+
+} // namespace minielf
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "minielf/MiniELF.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace minielf {
+
+/**
+ * @brief Bytes attributed to one segment or section entry of a SizeReport.
+ */
+struct SizeEntry {
+    static constexpr size_t NoParent = static_cast<size_t>(-1);
+
+    std::string name;        ///< Segment or section name, or a bracketed bucket such as "[Unmapped]"
+    uint64_t vmSize = 0;     ///< Bytes of the loaded image
+    uint64_t fileSize = 0;   ///< Bytes of the file
+    size_t parent = NoParent;///< Index of the enclosing entry one level up (none for segments)
+};
+
+/**
+ * @brief Bytes of an allocated section attributed to one symbol.
+ */
+struct SymbolSize {
+    const Symbol* symbol = nullptr; ///< Covering symbol, or nullptr for bytes no symbol covers
+    size_t section = 0;             ///< Index of the enclosing entry in SizeReport::getSections()
+    uint64_t vmSize = 0;            ///< Bytes of the loaded image
+    uint64_t fileSize = 0;          ///< Bytes of the file (0 for SHT_NOBITS sections)
+};
+
+/**
+ * @brief Attributes the file size and VM size of a binary to segments,
+ * sections and symbols.
+ *
+ * Every byte is counted exactly once per level, so each level sums to the
+ * file size and to the size of the loadable segments:
+ *   - Segments: the PT_LOAD segments, named like "LOAD #2 [RX]", plus
+ *     "[Unmapped]" for file bytes outside of them (symbol and debug tables,
+ *     section headers). Relocatable objects only have "[Unmapped]".
+ *   - Sections: the sections plus "[ELF header]", "[Program headers]" and
+ *     "[Section headers]"; bytes of a segment no section covers are given to
+ *     a bucket named after the segment, e.g. "[LOAD #2 [RX]]".
+ *   - Symbols: every byte of each SHF_ALLOC section goes to the symbol
+ *     covering it, or to a per-section gap entry with a null symbol.
+ *     Overlapping symbols (aliases, nested labels) are resolved in address
+ *     order: a byte goes to the first symbol that covers it.
+ *
+ * Sizes roll up: the sizes of the entries whose parent is an entry add up to
+ * that entry's sizes. Everything is computed in the constructor in one sweep
+ * over the address index of the file (per section for relocatable objects),
+ * so the cost is linear in the number of symbols after the index is built.
+ * The MiniELF object must outlive the report.
+ */
+class SizeReport {
+public:
+    /**
+     * @brief Attribute the bytes of a parsed file.
+     * @param elf Parsed ELF file.
+     */
+    explicit SizeReport(const MiniELF& elf);
+
+    /**
+     * @brief Get the segment entries (loadable segments, then "[Unmapped]").
+     * @return Reference to the segment entries.
+     */
+    const std::vector<SizeEntry>& getSegments() const { return _segments; }
+
+    /**
+     * @brief Get the section entries, grouped by segment.
+     * @return Reference to the section entries; parent indexes getSegments().
+     */
+    const std::vector<SizeEntry>& getSections() const { return _sections; }
+
+    /**
+     * @brief Get the symbol entries of all allocated sections, grouped by section.
+     * @return Reference to the symbol entries.
+     */
+    const std::vector<SymbolSize>& getSymbols() const { return _symbols; }
+
+    /**
+     * @brief Get the symbol entries of one section entry.
+     * @param section Index into getSections().
+     * @return View of the symbol entries, gap entry last (empty for unallocated sections).
+     */
+    Span<SymbolSize> getSymbolsInSection(size_t section) const;
+
+    /**
+     * @brief Get the total VM size (sum of the loadable segments).
+     * @return Number of bytes.
+     */
+    uint64_t getVmSize() const { return _vmSize; }
+
+    /**
+     * @brief Get the total file size.
+     * @return Number of bytes.
+     */
+    uint64_t getFileSize() const { return _fileSize; }
+
+private:
+    std::vector<SizeEntry> _segments;
+    std::vector<SizeEntry> _sections;
+    std::vector<SymbolSize> _symbols;
+    std::vector<size_t> _symbolOffsets; ///< Start of each section entry's symbols in _symbols
+    uint64_t _vmSize = 0;
+    uint64_t _fileSize = 0;
+};
+
+} // namespace minielf
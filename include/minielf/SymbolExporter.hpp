@@ -0,0 +1,87 @@
+#pragma once
+
+#include "minielf/MiniELF.hpp"
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace minielf {
+
+/**
+ * @brief Output formats supported by SymbolExporter.
+ */
+enum class ExportFormat {
+    PerfMap,    ///< perf JIT map (/tmp/perf-PID.map): "START SIZE name", functions only
+    Breakpad,   ///< Breakpad .sym: MODULE/INFO header and PUBLIC records
+    SymbolList  ///< "ADDRESS SIZE TYPE name" for every defined symbol
+};
+
+/**
+ * @brief Streaming symbol exporter.
+ *
+ * Walks the address-sorted symbol index once and formats records into a
+ * fixed-size buffer with hand-rolled hex conversion, handing the stream one
+ * large write per buffer. Undefined, unnamed, section and file symbols are
+ * never exported.
+ *
+ * The exporter refers to the MiniELF object it was built from, which must
+ * outlive it.
+ */
+class SymbolExporter {
+public:
+    /**
+     * @brief Prepare an exporter for an ELF file.
+     * @param elf Parsed ELF file.
+     */
+    explicit SymbolExporter(const MiniELF& elf) : _elf(elf) {}
+
+    /**
+     * @brief Check whether the file can be exported in a given format.
+     *
+     * Breakpad export needs a build ID: the module ID is derived from it, and
+     * a fixed ID would make unrelated modules collide in a symbol store.
+     * @param format Output format.
+     * @return false for Breakpad if the file has no build ID, true otherwise.
+     */
+    bool canWrite(ExportFormat format) const;
+
+    /**
+     * @brief Write all records in a given format.
+     * @param out    Output stream.
+     * @param format Output format.
+     * @param bias   Value added to every address (perf map and symbol list),
+     *               e.g. the load bias of a position-independent binary.
+     *               Breakpad addresses are always module-relative.
+     * @return Number of records written, excluding headers; nothing is
+     *         written if canWrite() is false.
+     */
+    size_t write(std::ostream& out, ExportFormat format, uint64_t bias = 0) const;
+
+    /**
+     * @brief Write all records to a file.
+     * @param path   Output file path (truncated).
+     * @param format Output format.
+     * @param bias   Value added to every address, see write().
+     * @return true if the file was written completely, false otherwise
+     *         (including when canWrite() is false).
+     */
+    bool writeFile(const std::string& path, ExportFormat format, uint64_t bias = 0) const;
+
+    /**
+     * @brief Compute the Breakpad module ID of a build ID.
+     *
+     * The first 16 bytes (zero padded) are read as a GUID whose first three
+     * fields are byte-swapped, printed in uppercase hex followed by an age of 0.
+     * An empty build ID gives an all-zero module ID, which is why write()
+     * refuses Breakpad export for files without one.
+     * @param buildId GNU build ID bytes.
+     * @return 33-character module ID.
+     */
+    static std::string breakpadModuleId(const std::vector<uint8_t>& buildId);
+
+private:
+    const MiniELF& _elf; ///< Source ELF file
+};
+
+} // namespace minielf
@@ -0,0 +1,134 @@
+#include "minielf/ByteSource.hpp"
+#include "MappedFile.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace minielf {
+
+/**
+ * @brief Get a zero-copy view of a byte range (unsupported by default).
+ * @return nullptr.
+ */
+const char* ByteSource::view(uint64_t, size_t) const {
+    return nullptr;
+}
+
+/**
+ * @brief Start a batch of reads, performed with readAt() when waited on.
+ * @param requests Array of requests.
+ * @param count    Number of requests.
+ * @return Deferred future completing the reads.
+ */
+std::future<void> ByteSource::readBatch(ReadRequest* requests, size_t count) const {
+    return std::async(std::launch::deferred, [this, requests, count]() {
+        for (size_t i = 0; i < count; ++i)
+            requests[i].bytesRead = readAt(requests[i].offset, requests[i].buffer, requests[i].size);
+    });
+}
+
+/**
+ * @brief Open a file.
+ * @param filepath Path to the file.
+ */
+FileByteSource::FileByteSource(const std::string& filepath) {
+    _fd = ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (_fd < 0) return;
+    struct stat st{};
+    if (::fstat(_fd, &st) != 0) {
+        ::close(_fd);
+        _fd = -1;
+        return;
+    }
+    _size = static_cast<uint64_t>(st.st_size);
+}
+
+FileByteSource::~FileByteSource() {
+    if (_fd >= 0) ::close(_fd);
+}
+
+/**
+ * @brief Read bytes at an offset with pread, retrying short reads.
+ * @param offset Offset in the file.
+ * @param buffer Destination buffer.
+ * @param size   Number of bytes to read.
+ * @return Number of bytes read.
+ */
+size_t FileByteSource::readAt(uint64_t offset, void* buffer, size_t size) const {
+    if (_fd < 0) return 0;
+    size_t done = 0;
+    while (done < size) {
+        ssize_t n = ::pread(_fd, static_cast<char*>(buffer) + done, size - done,
+                            static_cast<off_t>(offset + done));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        done += static_cast<size_t>(n);
+    }
+    return done;
+}
+
+/**
+ * @brief Map a file.
+ * @param filepath Path to the file.
+ */
+MmapByteSource::MmapByteSource(const std::string& filepath)
+    : _file(new detail::MappedFile(filepath)) {}
+
+MmapByteSource::~MmapByteSource() = default;
+
+/**
+ * @brief Check if the file was mapped successfully.
+ * @return true if mapped, false otherwise.
+ */
+bool MmapByteSource::isOpen() const {
+    return _file->isOpen();
+}
+
+/**
+ * @brief Get the size of the mapping.
+ * @return Size in bytes.
+ */
+uint64_t MmapByteSource::size() const {
+    return _file->size();
+}
+
+/**
+ * @brief Copy bytes out of the mapping.
+ * @return Number of bytes copied.
+ */
+size_t MmapByteSource::readAt(uint64_t offset, void* buffer, size_t size) const {
+    return MemoryByteSource(_file->data(), _file->size()).readAt(offset, buffer, size);
+}
+
+/**
+ * @brief Get a pointer into the mapping.
+ * @return Pointer to the bytes, or nullptr if the range is out of bounds.
+ */
+const char* MmapByteSource::view(uint64_t offset, size_t size) const {
+    return MemoryByteSource(_file->data(), _file->size()).view(offset, size);
+}
+
+/**
+ * @brief Copy bytes out of the region.
+ * @return Number of bytes copied.
+ */
+size_t MemoryByteSource::readAt(uint64_t offset, void* buffer, size_t size) const {
+    if (offset >= _size) return 0;
+    size_t n = static_cast<size_t>(std::min<uint64_t>(size, _size - offset));
+    memcpy(buffer, _data + offset, n);
+    return n;
+}
+
+/**
+ * @brief Get a pointer into the region.
+ * @return Pointer to the bytes, or nullptr if the range is out of bounds.
+ */
+const char* MemoryByteSource::view(uint64_t offset, size_t size) const {
+    if (offset > _size || size > _size - offset) return nullptr;
+    return _data + offset;
+}
+
+} // namespace minielf
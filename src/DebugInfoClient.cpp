@@ -0,0 +1,475 @@
+#include "minielf/DebugInfoClient.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <ctime>
+#include <exception>
+#include <fcntl.h>
+#include <netdb.h>
+#include <sstream>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace minielf {
+
+namespace {
+
+/**
+ * @brief Get the debuginfod name of an artifact.
+ */
+const char* artifactName(DebugArtifact artifact) {
+    return artifact == DebugArtifact::Executable ? "executable" : "debuginfo";
+}
+
+/**
+ * @brief Normalize a hex build ID to lowercase.
+ * @return false if the ID is empty, has an odd length or non-hex characters.
+ */
+bool normalizeBuildId(const std::string& in, std::string& out) {
+    if (in.empty() || in.size() % 2 != 0 || in.size() > 128) return false;
+    out.resize(in.size());
+    for (size_t i = 0; i < in.size(); ++i) {
+        char c = in[i];
+        if (c >= 'A' && c <= 'F') c = static_cast<char>(c - 'A' + 'a');
+        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) return false;
+        out[i] = c;
+    }
+    return true;
+}
+
+/**
+ * @brief Check whether a regular file exists.
+ */
+bool fileExists(const std::string& path) {
+    struct stat st{};
+    return ::stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+}
+
+/**
+ * @brief Create a directory and its missing parents.
+ * @return true if the directory exists afterwards.
+ */
+bool makeDirectories(const std::string& path) {
+    for (size_t pos = 1; pos <= path.size(); ++pos) {
+        if (pos != path.size() && path[pos] != '/') continue;
+        const std::string prefix = path.substr(0, pos);
+        if (::mkdir(prefix.c_str(), 0755) != 0 && errno != EEXIST) return false;
+    }
+    struct stat st{};
+    return ::stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+/**
+ * @brief Write a whole buffer to a file descriptor.
+ */
+bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(fd, data, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+/**
+ * @brief Components of an http:// URL.
+ */
+struct HttpUrl {
+    std::string host;
+    std::string port = "80";
+    std::string path; ///< Path prefix without trailing slash
+};
+
+/**
+ * @brief Split an http:// URL into host, port and path prefix.
+ * @return false if the URL is not a plain http URL.
+ */
+bool parseUrl(const std::string& url, HttpUrl& out) {
+    const std::string scheme = "http://";
+    if (url.compare(0, scheme.size(), scheme) != 0) return false;
+    size_t hostStart = scheme.size();
+    size_t pathStart = url.find('/', hostStart);
+    std::string authority = url.substr(hostStart, pathStart == std::string::npos ? std::string::npos : pathStart - hostStart);
+    out.path = pathStart == std::string::npos ? "" : url.substr(pathStart);
+    while (!out.path.empty() && out.path.back() == '/') out.path.pop_back();
+
+    if (!authority.empty() && authority[0] == '[') {
+        // IPv6 literal: [::1]:8002
+        size_t close = authority.find(']');
+        if (close == std::string::npos) return false;
+        out.host = authority.substr(1, close - 1);
+        if (close + 1 < authority.size() && authority[close + 1] == ':') out.port = authority.substr(close + 2);
+    } else {
+        size_t colon = authority.rfind(':');
+        out.host = authority.substr(0, colon);
+        if (colon != std::string::npos) out.port = authority.substr(colon + 1);
+    }
+    return !out.host.empty() && !out.port.empty();
+}
+
+/**
+ * @brief Perform one HTTP/1.0 GET request and store a 200 response body in a file.
+ * @return Found on 200, NotFound on 404, Error otherwise.
+ */
+FetchStatus httpGet(const HttpUrl& url, const std::string& path, const std::string& destination,
+                    int timeoutSeconds, std::string& error) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    if (int rc = ::getaddrinfo(url.host.c_str(), url.port.c_str(), &hints, &addresses); rc != 0) {
+        error = "cannot resolve " + url.host + ": " + gai_strerror(rc);
+        return FetchStatus::Error;
+    }
+    int fd = -1;
+    for (addrinfo* ai = addresses; ai && fd < 0; ai = ai->ai_next) {
+        fd = ::socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) continue;
+        timeval tv{timeoutSeconds, 0};
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+        if (::connect(fd, ai->ai_addr, ai->ai_addrlen) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    ::freeaddrinfo(addresses);
+    if (fd < 0) {
+        error = "cannot connect to " + url.host + ":" + url.port;
+        return FetchStatus::Error;
+    }
+
+    // HTTP/1.0 keeps the response simple: no chunked encoding, body ends at EOF
+    const std::string request = "GET " + url.path + path + " HTTP/1.0\r\nHost: " + url.host +
+                                "\r\nUser-Agent: minielf\r\nConnection: close\r\n\r\n";
+    if (!writeAll(fd, request.data(), request.size())) {
+        ::close(fd);
+        error = "cannot send request to " + url.host;
+        return FetchStatus::Error;
+    }
+
+    std::string head;
+    char buffer[65536];
+    size_t headerEnd = std::string::npos;
+    while (headerEnd == std::string::npos) {
+        ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0 || head.size() > 65536) {
+            ::close(fd);
+            error = "malformed response from " + url.host;
+            return FetchStatus::Error;
+        }
+        head.append(buffer, static_cast<size_t>(n));
+        headerEnd = head.find("\r\n\r\n");
+    }
+
+    // Status line: HTTP/1.x CODE reason
+    int status = 0;
+    size_t space = head.find(' ');
+    if (space != std::string::npos) status = std::atoi(head.c_str() + space + 1);
+    if (status == 404) {
+        ::close(fd);
+        return FetchStatus::NotFound;
+    }
+    if (status != 200) {
+        ::close(fd);
+        error = "HTTP " + std::to_string(status) + " from " + url.host;
+        return FetchStatus::Error;
+    }
+
+    uint64_t contentLength = UINT64_MAX;
+    std::string headers = head.substr(0, headerEnd);
+    std::transform(headers.begin(), headers.end(), headers.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    size_t lengthPos = headers.find("\r\ncontent-length:");
+    if (lengthPos != std::string::npos) contentLength = std::strtoull(headers.c_str() + lengthPos + 17, nullptr, 10);
+
+    int out = ::open(destination.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (out < 0) {
+        ::close(fd);
+        error = "cannot create " + destination;
+        return FetchStatus::Error;
+    }
+    uint64_t received = head.size() - headerEnd - 4;
+    bool ok = writeAll(out, head.data() + headerEnd + 4, static_cast<size_t>(received));
+    while (ok && received < contentLength) {
+        ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) ok = false;
+        if (n <= 0) break;
+        ok = writeAll(out, buffer, static_cast<size_t>(n));
+        received += static_cast<uint64_t>(n);
+    }
+    ::close(fd);
+    ok = ::close(out) == 0 && ok;
+    if (!ok || (contentLength != UINT64_MAX && received != contentLength)) {
+        error = "truncated response from " + url.host;
+        return FetchStatus::Error;
+    }
+    return FetchStatus::Found;
+}
+
+} // namespace
+
+/**
+ * @brief Create a fetcher for a list of servers.
+ * @param servers        Server URLs.
+ * @param timeoutSeconds Connect and receive timeout per request.
+ */
+HttpFetcher::HttpFetcher(std::vector<std::string> servers, int timeoutSeconds)
+    : _servers(std::move(servers)), _timeoutSeconds(timeoutSeconds) {}
+
+/**
+ * @brief Create a fetcher for the servers listed in $DEBUGINFOD_URLS.
+ * @return Fetcher, or nullptr if the variable is unset or empty.
+ */
+std::shared_ptr<HttpFetcher> HttpFetcher::fromEnvironment() {
+    const char* urls = std::getenv("DEBUGINFOD_URLS");
+    if (!urls) return nullptr;
+    std::vector<std::string> servers;
+    std::istringstream in(urls);
+    for (std::string url; in >> url;) servers.push_back(url);
+    if (servers.empty()) return nullptr;
+    return std::make_shared<HttpFetcher>(std::move(servers));
+}
+
+/**
+ * @brief Download an artifact from the first server that has it.
+ * @param buildId     Build ID as lowercase hex.
+ * @param artifact    Kind of file to download.
+ * @param destination Path of the file to write.
+ * @param error       Receives a description of the failure.
+ * @return Found, NotFound if every server answered 404, Error otherwise.
+ */
+FetchStatus HttpFetcher::fetch(const std::string& buildId, DebugArtifact artifact,
+                               const std::string& destination, std::string& error) {
+    const std::string path = "/buildid/" + buildId + "/" + artifactName(artifact);
+    FetchStatus result = FetchStatus::NotFound;
+    for (const auto& server : _servers) {
+        HttpUrl url;
+        if (!parseUrl(server, url)) {
+            error = "unsupported server URL: " + server;
+            result = FetchStatus::Error;
+            continue;
+        }
+        std::string serverError;
+        FetchStatus status = httpGet(url, path, destination, _timeoutSeconds, serverError);
+        if (status == FetchStatus::Found) return status;
+        if (status == FetchStatus::Error) {
+            // A miss is only definitive if every server answered
+            error = serverError;
+            result = FetchStatus::Error;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Create a client.
+ * @param cacheDirectory Cache directory.
+ * @param fetcher        Source of files missing from the cache.
+ */
+DebugInfoClient::DebugInfoClient(std::string cacheDirectory, std::shared_ptr<DebugInfoFetcher> fetcher)
+    : _cacheDirectory(std::move(cacheDirectory)), _fetcher(std::move(fetcher)) {
+    while (_cacheDirectory.size() > 1 && _cacheDirectory.back() == '/') _cacheDirectory.pop_back();
+}
+
+/**
+ * @brief Get the default cache directory.
+ * @return Cache directory path.
+ */
+std::string DebugInfoClient::defaultCacheDirectory() {
+    if (const char* path = std::getenv("DEBUGINFOD_CACHE_PATH"); path && *path) return path;
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) return std::string(xdg) + "/debuginfod_client";
+    const char* home = std::getenv("HOME");
+    return std::string(home && *home ? home : "/tmp") + "/.cache/debuginfod_client";
+}
+
+/**
+ * @brief Set how long a miss is remembered.
+ * @param seconds Time in seconds; 0 disables negative caching.
+ */
+void DebugInfoClient::setNegativeCacheTtl(int seconds) {
+    _negativeTtl = seconds;
+}
+
+/**
+ * @brief Look up a file by build ID.
+ * @param buildId  Build ID bytes.
+ * @param artifact Kind of file.
+ * @return Lookup result.
+ */
+FetchResult DebugInfoClient::find(const std::vector<uint8_t>& buildId, DebugArtifact artifact) {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex;
+    hex.reserve(buildId.size() * 2);
+    for (uint8_t b : buildId) {
+        hex += digits[b >> 4];
+        hex += digits[b & 0xf];
+    }
+    return find(hex, artifact);
+}
+
+/**
+ * @brief Look up a file by build ID given as hex.
+ * @param buildId  Build ID as hex.
+ * @param artifact Kind of file.
+ * @return Lookup result.
+ */
+FetchResult DebugInfoClient::find(const std::string& buildId, DebugArtifact artifact) {
+    FetchResult result;
+    std::string id;
+    if (!normalizeBuildId(buildId, id)) {
+        result.error = "invalid build ID: " + buildId;
+        return result;
+    }
+    const std::string path = _cacheDirectory + "/" + id + "/" + artifactName(artifact);
+    if (fileExists(path)) {
+        result.status = FetchStatus::Found;
+        result.path = path;
+        return result;
+    }
+
+    // Join a running fetch of the same file, or become the one running it
+    const std::string key = id + "/" + artifactName(artifact);
+    std::promise<FetchResult> promise;
+    std::shared_future<FetchResult> pending;
+    bool leader = false;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _inflight.find(key);
+        if (it != _inflight.end()) {
+            pending = it->second;
+        } else {
+            pending = promise.get_future().share();
+            _inflight.emplace(key, pending);
+            leader = true;
+        }
+    }
+    if (!leader) return pending.get();
+
+    // Unregister on every path, or later lookups of the key would wait forever
+    struct InflightGuard {
+        DebugInfoClient& client;
+        const std::string& key;
+        ~InflightGuard() {
+            std::lock_guard<std::mutex> lock(client._mutex);
+            client._inflight.erase(key);
+        }
+    } guard{*this, key};
+    try {
+        result = fetchAndStore(id, artifact);
+    } catch (const std::exception& e) {
+        result = FetchResult();
+        result.error = std::string("fetch failed: ") + e.what();
+    } catch (...) {
+        result = FetchResult();
+        result.error = "fetch failed";
+    }
+    promise.set_value(result);
+    return result;
+}
+
+/**
+ * @brief Look up the separate debug information of a parsed file.
+ * @param elf Parsed file.
+ * @return Lookup result.
+ */
+FetchResult DebugInfoClient::findDebugInfo(const MiniELF& elf) {
+    if (elf.getBuildId().empty()) {
+        FetchResult result;
+        result.error = "no build ID: " + elf.getFilePath();
+        return result;
+    }
+    return find(elf.getBuildId(), DebugArtifact::DebugInfo);
+}
+
+/**
+ * @brief Get the number of times the fetcher was invoked.
+ * @return Number of fetches.
+ */
+size_t DebugInfoClient::getFetchCount() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _fetchCount;
+}
+
+/**
+ * @brief Fetch a file missing from the cache and store the outcome.
+ *
+ * The download goes to a temporary file renamed into place, so readers never
+ * see partial files. A miss leaves an empty marker file whose modification
+ * time bounds how long the miss is remembered.
+ * @param buildId  Validated lowercase hex build ID.
+ * @param artifact Kind of file.
+ * @return Lookup result.
+ */
+FetchResult DebugInfoClient::fetchAndStore(const std::string& buildId, DebugArtifact artifact) {
+    FetchResult result;
+    const std::string directory = _cacheDirectory + "/" + buildId;
+    const std::string path = directory + "/" + artifactName(artifact);
+    const std::string missMarker = directory + "/." + artifactName(artifact) + ".miss";
+
+    // Another thread or process may have completed the lookup meanwhile
+    if (fileExists(path)) {
+        result.status = FetchStatus::Found;
+        result.path = path;
+        return result;
+    }
+    struct stat st{};
+    if (_negativeTtl > 0 && ::stat(missMarker.c_str(), &st) == 0 &&
+        std::time(nullptr) - st.st_mtime < _negativeTtl) {
+        result.status = FetchStatus::NotFound;
+        return result;
+    }
+    if (!_fetcher) {
+        result.status = FetchStatus::NotFound;
+        return result;
+    }
+    if (!makeDirectories(directory)) {
+        result.error = "cannot create cache directory " + directory;
+        return result;
+    }
+
+    static std::atomic<unsigned> tempCounter{0};
+    const std::string temp = path + ".tmp." + std::to_string(::getpid()) + "." + std::to_string(tempCounter++);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_fetchCount;
+    }
+    try {
+        result.status = _fetcher->fetch(buildId, artifact, temp, result.error);
+    } catch (...) {
+        ::unlink(temp.c_str());
+        throw;
+    }
+
+    if (result.status == FetchStatus::Found) {
+        if (::rename(temp.c_str(), path.c_str()) != 0) {
+            ::unlink(temp.c_str());
+            result.status = FetchStatus::Error;
+            result.error = "cannot store " + path;
+            return result;
+        }
+        ::unlink(missMarker.c_str());
+        result.path = path;
+        result.error.clear();
+        return result;
+    }
+    ::unlink(temp.c_str());
+    if (result.status == FetchStatus::NotFound) {
+        // Touch the marker; its modification time is the time of the miss
+        int fd = ::open(missMarker.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd >= 0) ::close(fd);
+        result.error.clear();
+    }
+    return result;
+}
+
+} // namespace minielf
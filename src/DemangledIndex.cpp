@@ -0,0 +1,271 @@
+#include "minielf/DemangledIndex.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <stdlib.h>
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#define MINIELF_HAVE_CXXABI 1
+#endif
+
+namespace minielf {
+
+namespace {
+
+/**
+ * @brief Demangle into a reusable malloc'd buffer.
+ * @return Pointer to the NUL-terminated demangled name, or nullptr on failure.
+ */
+const char* demangleInto(const char* name, char*& buffer, size_t& capacity) {
+#if defined(MINIELF_HAVE_CXXABI)
+    if (name[0] != '_' || name[1] != 'Z') return nullptr;
+    int status = 0;
+    char* out = abi::__cxa_demangle(name, buffer, &capacity, &status);
+    if (status != 0 || !out) return nullptr;
+    buffer = out; // may have been reallocated
+    return out;
+#else
+    (void)name; (void)buffer; (void)capacity;
+    return nullptr;
+#endif
+}
+
+/**
+ * @brief Check whether a character can be part of an identifier.
+ */
+bool isIdentifierChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+/**
+ * @brief Locate the qualified name inside a demangled name.
+ *
+ * Drops the return type printed before template functions and the parameter
+ * list (with anything after it) of functions: "int ns::twice<int>(int)"
+ * gives "ns::twice<int>". Names without a parameter list, such as variables
+ * or "vtable for ns::A", are kept whole. Local entities ("f(int)::count")
+ * keep the parameter list of their enclosing function.
+ * @param name Demangled name.
+ * @return Offset and length of the qualified name.
+ */
+std::pair<size_t, size_t> qualifiedNameSpan(std::string_view name) {
+    static constexpr std::string_view anonymous = "(anonymous namespace)";
+    static constexpr std::string_view keyword = "operator";
+    static constexpr std::string_view operatorChars = "+-*/%^&|~!=<>,\"";
+    size_t start = 0;
+    int depth = 0;
+    bool afterOperator = false; // "operator new", "operator int": the spaces belong to the name
+    for (size_t i = 0; i < name.size(); ++i) {
+        const char c = name[i];
+        if (depth == 0 && name.compare(i, anonymous.size(), anonymous) == 0) {
+            i += anonymous.size() - 1;
+        } else if (depth == 0 && name.compare(i, keyword.size(), keyword) == 0 &&
+                   (i == 0 || !isIdentifierChar(name[i - 1])) &&
+                   (i + keyword.size() == name.size() || !isIdentifierChar(name[i + keyword.size()]))) {
+            // Skip the operator symbol, whose brackets are not nesting
+            i += keyword.size();
+            if (name.compare(i, 2, "()") == 0 || name.compare(i, 2, "[]") == 0) {
+                i += 2;
+            } else {
+                while (i < name.size() && operatorChars.find(name[i]) != std::string_view::npos) ++i;
+            }
+            --i;
+            afterOperator = true;
+        } else if (c == ' ' && depth == 0) {
+            if (!afterOperator) start = i + 1;
+        } else if (c == '(' && depth == 0 && i > start && name[i - 1] != ' ') {
+            // Parameter list, unless a local entity of the function follows it
+            size_t close = i + 1;
+            for (int inner = 1; close < name.size() && inner > 0; ++close) {
+                if (name[close] == '(') ++inner;
+                else if (name[close] == ')') --inner;
+            }
+            if (name.compare(close, 2, "::") != 0) return {start, i - start};
+            i = close + 1;
+        } else if (c == '<' || c == '(' || c == '[' || c == '{') {
+            ++depth;
+        } else if ((c == '>' || c == ')' || c == ']' || c == '}') && depth > 0) {
+            --depth;
+        }
+    }
+    return {0, name.size()};
+}
+
+} // namespace
+
+/**
+ * @brief Build the index over all mangled symbols of an ELF file.
+ * @param elf     Parsed ELF file.
+ * @param threads Number of worker threads (0 = hardware concurrency).
+ */
+DemangledIndex::DemangledIndex(const MiniELF& elf, unsigned threads) {
+    const auto& symbols = elf.getSymbols();
+    const size_t count = symbols.size();
+    const unsigned chunks = detail::resolveThreadCount(threads, count);
+
+    // Each worker demangles a slice into its own arena
+    struct Part {
+        std::string arena;
+        std::vector<Entry> entries;
+        std::vector<const Symbol*> symbols;
+    };
+    std::vector<Part> parts(chunks);
+    detail::parallelForEach(chunks, chunks, [&](size_t c) {
+        Part& part = parts[c];
+        char* buffer = static_cast<char*>(malloc(256));
+        size_t capacity = 256;
+        for (size_t i = count * c / chunks; i < count * (c + 1) / chunks; ++i) {
+            const char* name = demangleInto(symbols[i].name.c_str(), buffer, capacity);
+            if (!name) continue;
+            std::string_view view(name);
+            auto qualified = qualifiedNameSpan(view);
+            part.entries.push_back({part.arena.size(), static_cast<uint32_t>(view.size()),
+                                    static_cast<uint32_t>(qualified.first), static_cast<uint32_t>(qualified.second)});
+            part.symbols.push_back(&symbols[i]);
+            part.arena.append(view);
+        }
+        free(buffer);
+    });
+
+    // Stitch the parts into one arena
+    size_t arenaSize = 0, entryCount = 0;
+    for (const auto& part : parts) {
+        arenaSize += part.arena.size();
+        entryCount += part.entries.size();
+    }
+    _arena.reserve(arenaSize);
+    std::vector<Entry> entries;
+    std::vector<const Symbol*> owners;
+    entries.reserve(entryCount);
+    owners.reserve(entryCount);
+    for (auto& part : parts) {
+        uint64_t base = _arena.size();
+        _arena.append(part.arena);
+        for (auto e : part.entries) {
+            e.offset += base;
+            entries.push_back(e);
+        }
+        owners.insert(owners.end(), part.symbols.begin(), part.symbols.end());
+        part = Part();
+    }
+
+    // Sort by demangled name; ties keep symbol table order
+    std::vector<uint32_t> order(entries.size());
+    std::iota(order.begin(), order.end(), 0u);
+    auto nameOf = [&](uint32_t i) { return std::string_view(_arena.data() + entries[i].offset, entries[i].length); };
+    std::stable_sort(order.begin(), order.end(),
+        [&](uint32_t a, uint32_t b) { return nameOf(a) < nameOf(b); });
+    _entries.reserve(order.size());
+    _symbols.reserve(order.size());
+    for (uint32_t i : order) {
+        _entries.push_back(entries[i]);
+        _symbols.push_back(owners[i]);
+    }
+
+    // Positions sorted by qualified name; ties keep demangled name order
+    _byQualified.resize(_entries.size());
+    std::iota(_byQualified.begin(), _byQualified.end(), 0u);
+    std::stable_sort(_byQualified.begin(), _byQualified.end(),
+        [&](uint32_t a, uint32_t b) { return getQualifiedName(a) < getQualifiedName(b); });
+}
+
+/**
+ * @brief Get the demangled name stored for a position of the index.
+ * @param position Position in the index.
+ * @return Demangled name.
+ */
+std::string_view DemangledIndex::getName(size_t position) const {
+    const Entry& e = _entries[position];
+    return std::string_view(_arena.data() + e.offset, e.length);
+}
+
+/**
+ * @brief Get the qualified name stored for a position of the index.
+ * @param position Position in the index.
+ * @return Demangled name without return type and parameter list.
+ */
+std::string_view DemangledIndex::getQualifiedName(size_t position) const {
+    const Entry& e = _entries[position];
+    return std::string_view(_arena.data() + e.offset + e.qualifiedStart, e.qualifiedLength);
+}
+
+/**
+ * @brief Position of the first entry not less than a name.
+ */
+size_t DemangledIndex::lowerBound(std::string_view name) const {
+    size_t lo = 0, hi = _entries.size();
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (getName(mid) < name) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * @brief Span of entries in [first, last) positions.
+ */
+SymbolSpan DemangledIndex::slice(size_t first, size_t last) const {
+    return SymbolSpan(_symbols.data() + first, _symbols.data() + last);
+}
+
+/**
+ * @brief Find symbols whose demangled name equals a string.
+ * @param name Demangled name.
+ * @return Span of matching symbols.
+ */
+SymbolSpan DemangledIndex::findExact(std::string_view name) const {
+    size_t first = lowerBound(name);
+    size_t last = first;
+    while (last < _entries.size() && getName(last) == name) ++last;
+    return slice(first, last);
+}
+
+/**
+ * @brief Find symbols whose demangled name starts with a prefix.
+ * @param prefix Demangled name prefix.
+ * @return Span of matching symbols, ordered by demangled name.
+ */
+SymbolSpan DemangledIndex::findPrefix(std::string_view prefix) const {
+    size_t first = lowerBound(prefix);
+    size_t lo = first, hi = _entries.size();
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (getName(mid).compare(0, prefix.size(), prefix) == 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return slice(first, lo);
+}
+
+/**
+ * @brief Find symbols by qualified name, ignoring function parameters.
+ * @param qualifiedName Qualified name without parameter list.
+ * @return Matching symbols, ordered by demangled name.
+ */
+std::vector<const Symbol*> DemangledIndex::findQualified(std::string_view qualifiedName) const {
+    auto first = std::lower_bound(_byQualified.begin(), _byQualified.end(), qualifiedName,
+        [this](uint32_t position, std::string_view name) { return getQualifiedName(position) < name; });
+    auto last = std::upper_bound(first, _byQualified.end(), qualifiedName,
+        [this](std::string_view name, uint32_t position) { return name < getQualifiedName(position); });
+    std::vector<const Symbol*> result;
+    result.reserve(last - first);
+    for (auto it = first; it != last; ++it) result.push_back(_symbols[*it]);
+    return result;
+}
+
+/**
+ * @brief Demangle a single symbol name.
+ * @param name Mangled name.
+ * @return Demangled name, or an empty string.
+ */
+std::string DemangledIndex::demangle(const std::string& name) {
+    char* buffer = nullptr;
+    size_t capacity = 0;
+    const char* out = demangleInto(name.c_str(), buffer, capacity);
+    std::string result = out ? out : "";
+    free(buffer);
+    return result;
+}
+
+} // namespace minielf
@@ -0,0 +1,143 @@
+#include "minielf/ElfDiff.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace minielf {
+
+namespace {
+
+/**
+ * @brief Merge two name-sorted pointer arrays, pairing entries of equal name in order.
+ *
+ * report(before, after) is called for every accepted entry; one side is
+ * nullptr when a name has fewer accepted entries there.
+ */
+template <typename T, typename Accept, typename Report>
+void mergeByName(const T* const* a, size_t na, const T* const* b, size_t nb, Accept accept, Report report) {
+    size_t i = 0, j = 0;
+    while (i < na || j < nb) {
+        const int cmp = i == na ? 1 : j == nb ? -1 : a[i]->name.compare(b[j]->name);
+        size_t iEnd = i, jEnd = j;
+        if (cmp <= 0) {
+            iEnd = i + 1;
+            while (iEnd < na && a[iEnd]->name == a[i]->name) ++iEnd;
+        }
+        if (cmp >= 0) {
+            jEnd = j + 1;
+            while (jEnd < nb && b[jEnd]->name == b[j]->name) ++jEnd;
+        }
+        for (size_t x = i, y = j;;) {
+            while (x < iEnd && !accept(*a[x])) ++x;
+            while (y < jEnd && !accept(*b[y])) ++y;
+            if (x == iEnd && y == jEnd) break;
+            report(x < iEnd ? a[x++] : nullptr, y < jEnd ? b[y++] : nullptr);
+        }
+        i = iEnd;
+        j = jEnd;
+    }
+}
+
+/**
+ * @brief Get the sections of a file ordered by name (stable).
+ */
+std::vector<const Section*> sectionsByName(const MiniELF& elf) {
+    std::vector<const Section*> sections;
+    sections.reserve(elf.getSections().size());
+    for (const auto& sec : elf.getSections()) {
+        if (!sec.name.empty()) sections.push_back(&sec);
+    }
+    std::stable_sort(sections.begin(), sections.end(),
+        [](const Section* a, const Section* b) { return a->name < b->name; });
+    return sections;
+}
+
+} // namespace
+
+/**
+ * @brief Report added, removed and resized symbols.
+ * @param callback Called for every difference.
+ * @return Totals of the reported differences.
+ */
+DiffStats ElfDiff::diffSymbols(const std::function<void(const SymbolDiff&)>& callback) const {
+    return mergeSymbols([](const Symbol&) { return true; }, callback);
+}
+
+/**
+ * @brief Report added, removed and resized symbols of one type.
+ * @param type     Symbol type to compare.
+ * @param callback Called for every difference.
+ * @return Totals of the reported differences.
+ */
+DiffStats ElfDiff::diffSymbols(SymbolType type, const std::function<void(const SymbolDiff&)>& callback) const {
+    return mergeSymbols([type](const Symbol& sym) { return sym.type == type; }, callback);
+}
+
+/**
+ * @brief Merge the name indexes, reporting symbols accepted by a filter.
+ * @param accept   Filter applied to both files.
+ * @param callback Called for every difference.
+ * @return Totals of the reported differences.
+ */
+DiffStats ElfDiff::mergeSymbols(const std::function<bool(const Symbol&)>& accept,
+                                const std::function<void(const SymbolDiff&)>& callback) const {
+    DiffStats stats;
+    const SymbolSpan a = _before.getSymbolsSortedByName();
+    const SymbolSpan b = _after.getSymbolsSortedByName();
+    auto filter = [&accept](const Symbol& sym) {
+        return sym.type != SymbolType::SECTION && sym.type != SymbolType::FILE && accept(sym);
+    };
+    mergeByName(a.begin(), a.size(), b.begin(), b.size(), filter,
+        [&](const Symbol* before, const Symbol* after) {
+            SymbolDiff diff{DiffKind::Resized, before, after};
+            if (!before) {
+                diff.kind = DiffKind::Added;
+                ++stats.added;
+            } else if (!after) {
+                diff.kind = DiffKind::Removed;
+                ++stats.removed;
+            } else if (before->size != after->size) {
+                ++stats.changed;
+            } else {
+                return;
+            }
+            stats.sizeDelta += static_cast<int64_t>(after ? after->size : 0) -
+                               static_cast<int64_t>(before ? before->size : 0);
+            callback(diff);
+        });
+    return stats;
+}
+
+/**
+ * @brief Report added, removed, resized and modified sections.
+ * @param callback Called for every difference.
+ * @return Totals of the reported differences.
+ */
+DiffStats ElfDiff::diffSections(const std::function<void(const SectionDiff&)>& callback) const {
+    DiffStats stats;
+    const auto a = sectionsByName(_before);
+    const auto b = sectionsByName(_after);
+    mergeByName(a.data(), a.size(), b.data(), b.size(), [](const Section&) { return true; },
+        [&](const Section* before, const Section* after) {
+            SectionDiff diff{DiffKind::Resized, before, after};
+            if (!before) {
+                diff.kind = DiffKind::Added;
+                ++stats.added;
+            } else if (!after) {
+                diff.kind = DiffKind::Removed;
+                ++stats.removed;
+            } else if (before->size != after->size) {
+                ++stats.changed;
+            } else if (before->hash && after->hash && *before->hash != *after->hash) {
+                diff.kind = DiffKind::Modified;
+                ++stats.changed;
+            } else {
+                return;
+            }
+            stats.sizeDelta += static_cast<int64_t>(after ? after->size : 0) -
+                               static_cast<int64_t>(before ? before->size : 0);
+            callback(diff);
+        });
+    return stats;
+}
+
+} // namespace minielf
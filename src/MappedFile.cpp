@@ -0,0 +1,42 @@
+#include "MappedFile.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace minielf {
+namespace detail {
+
+/**
+ * @brief Map a file into memory.
+ * @param filepath Path to the file.
+ */
+MappedFile::MappedFile(const std::string& filepath) {
+    int fd = ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return;
+
+    struct stat st{};
+    if (::fstat(fd, &st) == 0) {
+        _size = static_cast<size_t>(st.st_size);
+        if (_size == 0) {
+            _open = true;
+        } else {
+            void* addr = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                _data = static_cast<const char*>(addr);
+                _open = true;
+            }
+        }
+    }
+    ::close(fd);
+}
+
+/**
+ * @brief Release the mapping.
+ */
+MappedFile::~MappedFile() {
+    if (_data) ::munmap(const_cast<char*>(_data), _size);
+}
+
+} // namespace detail
+} // namespace minielf
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+namespace minielf {
+namespace detail {
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * Internal helper: the mapping is released when the object is destroyed.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Map a file into memory.
+     * @param filepath Path to the file.
+     */
+    explicit MappedFile(const std::string& filepath);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Check if the file was mapped successfully.
+     * @return true if mapped (an empty file counts as mapped), false otherwise.
+     */
+    bool isOpen() const { return _open; }
+
+    /**
+     * @brief Get a pointer to the mapped bytes.
+     * @return Pointer to the first byte, or nullptr for empty/unmapped files.
+     */
+    const char* data() const { return _data; }
+
+    /**
+     * @brief Get the size of the mapping.
+     * @return Size in bytes.
+     */
+    size_t size() const { return _size; }
+
+private:
+    const char* _data = nullptr; ///< Start of the mapping
+    size_t _size = 0;            ///< Size of the mapping in bytes
+    bool _open = false;          ///< Mapping validity flag
+};
+
+} // namespace detail
+} // namespace minielf
@@ -0,0 +1,114 @@
+#include "minielf/MappedView.hpp"
+#include <algorithm>
+
+namespace minielf {
+
+/**
+ * @brief Create a view with a known load bias.
+ * @param elf  Parsed ELF file.
+ * @param bias Runtime address minus file address.
+ */
+MappedView::MappedView(const MiniELF& elf, uint64_t bias) : _elf(&elf), _bias(bias) {
+    // Loaded extent from the PT_LOAD segments, or the allocated sections when
+    // there are no program headers
+    bool found = false;
+    for (const auto& ph : elf.getProgramHeaders()) {
+        if (ph.p_type != 1 /* PT_LOAD */) continue;
+        _low = found ? std::min(_low, ph.p_vaddr) : ph.p_vaddr;
+        _high = std::max(_high, ph.p_vaddr + ph.p_memsz);
+        found = true;
+    }
+    if (!found) {
+        for (const auto& sec : elf.getSections()) {
+            if (sec.address == 0) continue;
+            _low = found ? std::min(_low, sec.address) : sec.address;
+            _high = std::max(_high, sec.address + sec.size);
+            found = true;
+        }
+    }
+
+    // Build the shared address indexes now, so lookups through views never write
+    elf.getSymbolsSortedByAddress();
+}
+
+/**
+ * @brief Create a view from a memory mapping.
+ * @param elf        Parsed ELF file.
+ * @param start      Start address of the mapping.
+ * @param fileOffset File offset the mapping starts at.
+ * @return View over the mapping.
+ */
+MappedView MappedView::fromMapping(const MiniELF& elf, uint64_t start, uint64_t fileOffset) {
+    for (const auto& ph : elf.getProgramHeaders()) {
+        if (ph.p_type != 1 /* PT_LOAD */) continue;
+        // Mappings start on page boundaries, which may precede p_offset
+        uint64_t pageOffset = ph.p_align > 1 ? ph.p_offset & ~(ph.p_align - 1) : ph.p_offset;
+        if (fileOffset >= pageOffset && fileOffset < ph.p_offset + std::max(ph.p_filesz, uint64_t(1)))
+            return MappedView(elf, start - (ph.p_vaddr - ph.p_offset + fileOffset));
+    }
+    return MappedView(elf, start - fileOffset);
+}
+
+/**
+ * @brief Check whether a runtime address lies in the mapped image.
+ * @param runtimeAddress Address in the mapping process.
+ * @return true if the address falls inside the loaded extent of the file.
+ */
+bool MappedView::contains(uint64_t runtimeAddress) const {
+    return toFileAddress(runtimeAddress).has_value();
+}
+
+/**
+ * @brief Translate a runtime address to a file address.
+ * @param runtimeAddress Address in the mapping process.
+ * @return File address, or std::nullopt if the address lies outside the mapped image.
+ */
+std::optional<uint64_t> MappedView::toFileAddress(uint64_t runtimeAddress) const {
+    // Modular on purpose: an image loaded below its link address has a wrapped bias.
+    uint64_t addr = runtimeAddress - _bias;
+    if (addr < _low || addr >= _high) return std::nullopt;
+    return addr;
+}
+
+/**
+ * @brief Get the symbol covering a runtime address.
+ * @param runtimeAddress Address in the mapping process.
+ * @return Pointer to Symbol if found, nullptr otherwise.
+ */
+const Symbol* MappedView::getSymbolByAddress(uint64_t runtimeAddress) const {
+    auto addr = toFileAddress(runtimeAddress);
+    return addr ? _elf->getSymbolByAddress(*addr) : nullptr;
+}
+
+/**
+ * @brief Find the nearest symbol at or before a runtime address.
+ * @param runtimeAddress Address in the mapping process.
+ * @return Pointer to nearest Symbol if found, nullptr otherwise.
+ */
+const Symbol* MappedView::getNearestSymbol(uint64_t runtimeAddress) const {
+    auto addr = toFileAddress(runtimeAddress);
+    return addr ? _elf->getNearestSymbol(*addr) : nullptr;
+}
+
+/**
+ * @brief Get the section containing a runtime address.
+ * @param runtimeAddress Address in the mapping process.
+ * @return Pointer to Section if found, nullptr otherwise.
+ */
+const Section* MappedView::getSectionByAddress(uint64_t runtimeAddress) const {
+    auto addr = toFileAddress(runtimeAddress);
+    return addr ? _elf->getSectionByAddress(*addr) : nullptr;
+}
+
+/**
+ * @brief Get the runtime address of a symbol by name.
+ * @param name Name of the symbol.
+ * @return Runtime address, or std::nullopt if no symbol has this name.
+ */
+std::optional<uint64_t> MappedView::getSymbolAddress(std::string_view name) const {
+    const Symbol* sym = _elf->getSymbolByName(name);
+    if (!sym) return std::nullopt;
+    return getRuntimeAddress(*sym);
+}
+
+} // namespace minielf
@@ -0,0 +1,294 @@
+#include "minielf/MiniArchive.hpp"
+#include "MappedFile.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <string.h>
+
+namespace minielf {
+
+namespace {
+
+constexpr size_t kArchiveMagicSize = 8;   ///< Size of "!<arch>\n"
+constexpr size_t kMemberHeaderSize = 60;  ///< Size of struct ar_hdr
+
+/**
+ * @brief Read an unsigned big-endian integer of the given width.
+ */
+uint64_t readBigEndian(const char* p, size_t width) {
+    uint64_t v = 0;
+    for (size_t i = 0; i < width; ++i) v = (v << 8) | static_cast<unsigned char>(p[i]);
+    return v;
+}
+
+/**
+ * @brief Read an unsigned little-endian integer of the given width.
+ */
+uint64_t readLittleEndian(const char* p, size_t width) {
+    uint64_t v = 0;
+    for (size_t i = width; i-- > 0;) v = (v << 8) | static_cast<unsigned char>(p[i]);
+    return v;
+}
+
+/**
+ * @brief Parse a space-padded decimal header field.
+ * @return true if the field holds a valid number.
+ */
+bool parseDecimal(const char* p, size_t width, uint64_t& out) {
+    out = 0;
+    size_t i = 0;
+    while (i < width && p[i] == ' ') ++i;
+    if (i == width || p[i] < '0' || p[i] > '9') return false;
+    for (; i < width && p[i] >= '0' && p[i] <= '9'; ++i) out = out * 10 + (p[i] - '0');
+    for (; i < width; ++i) if (p[i] != ' ') return false;
+    return true;
+}
+
+} // namespace
+
+/**
+ * @brief Construct a MiniArchive object and parse the archive file.
+ * @param filepath Path to the archive.
+ */
+MiniArchive::MiniArchive(const std::string& filepath)
+    : _filepath(filepath), _file(new detail::MappedFile(filepath)) {
+    parse();
+    _elves.resize(_members.size());
+    _elfOnce.reset(new std::once_flag[_members.size()]);
+}
+
+MiniArchive::~MiniArchive() = default;
+
+/**
+ * @brief Check if the archive was parsed successfully.
+ * @return true if valid, false otherwise.
+ */
+bool MiniArchive::isValid() const {
+    return _valid;
+}
+
+/**
+ * @brief Get the list of archive members.
+ * @return Reference to the vector of members.
+ */
+const std::vector<ArchiveMember>& MiniArchive::getMembers() const {
+    return _members;
+}
+
+/**
+ * @brief Get the archive symbol index.
+ * @return Reference to the vector of index entries.
+ */
+const std::vector<ArchiveSymbol>& MiniArchive::getSymbolIndex() const {
+    return _symbolIndex;
+}
+
+/**
+ * @brief Get the parsed ELF object of a member, parsing it on first use.
+ * @param index Index of the member.
+ * @return Pointer to MiniELF, nullptr if index is out of range.
+ */
+const MiniELF* MiniArchive::getMemberELF(size_t index) const {
+    if (index >= _members.size()) return nullptr;
+    std::call_once(_elfOnce[index], [&]() {
+        const auto& m = _members[index];
+        _elves[index].reset(new MiniELF(_file->data() + m.offset, m.size,
+                                        _filepath + "(" + m.name + ")"));
+    });
+    return _elves[index].get();
+}
+
+/**
+ * @brief Parse all members in parallel.
+ * @param threads Number of worker threads (0 = hardware concurrency).
+ */
+void MiniArchive::loadMembers(unsigned threads) const {
+    detail::parallelForEach(_members.size(), threads,
+                            [this](size_t i) { getMemberELF(i); });
+}
+
+/**
+ * @brief Find the member defining a symbol using the archive symbol index.
+ * @param name Name of the symbol.
+ * @return Pointer to ArchiveMember if found, nullptr otherwise.
+ */
+const ArchiveMember* MiniArchive::findMemberForSymbol(std::string_view name) const {
+    auto it = _memberBySymbol.find(name);
+    return it != _memberBySymbol.end() ? &_members[it->second] : nullptr;
+}
+
+/**
+ * @brief Parse the archive headers and symbol index.
+ */
+void MiniArchive::parse() {
+    if (!_file->isOpen()) {
+        setError("MiniArchive error: failed to open file: " + _filepath);
+        return;
+    }
+
+    const char* data = _file->data();
+    const uint64_t fileSize = _file->size();
+    if (fileSize < kArchiveMagicSize || memcmp(data, "!<arch>\n", kArchiveMagicSize) != 0) {
+        setError("MiniArchive error: not an ar archive");
+        return;
+    }
+
+    const char* longNames = nullptr;
+    uint64_t longNamesSize = 0;
+    const char* index = nullptr;
+    uint64_t indexSize = 0;
+    bool indexBsd = false;
+    bool indexWide = false;
+
+    uint64_t pos = kArchiveMagicSize;
+    while (pos + kMemberHeaderSize <= fileSize) {
+        const char* hdr = data + pos;
+        uint64_t size = 0;
+        if (hdr[58] != '`' || hdr[59] != '\n' || !parseDecimal(hdr + 48, 10, size)) {
+            setError("MiniArchive error: malformed member header at offset " + std::to_string(pos));
+            return;
+        }
+        uint64_t dataOffset = pos + kMemberHeaderSize;
+        if (size > fileSize - dataOffset) {
+            setError("MiniArchive error: member exceeds archive size at offset " + std::to_string(pos));
+            return;
+        }
+
+        std::string rawName(hdr, 16);
+        rawName.erase(rawName.find_last_not_of(' ') + 1);
+
+        ArchiveMember member{};
+        member.headerOffset = pos;
+        member.offset = dataOffset;
+        member.size = size;
+
+        if (rawName == "/" || rawName == "/SYM64/") {
+            index = data + dataOffset;
+            indexSize = size;
+            indexWide = rawName != "/";
+        } else if (rawName == "//") {
+            longNames = data + dataOffset;
+            longNamesSize = size;
+        } else if (rawName.compare(0, 3, "#1/") == 0) {
+            // BSD: the name is stored at the start of the member data
+            uint64_t nameLen = 0;
+            if (!parseDecimal(rawName.data() + 3, rawName.size() - 3, nameLen) || nameLen > size) {
+                setError("MiniArchive error: malformed BSD member name at offset " + std::to_string(pos));
+                return;
+            }
+            const char* namePtr = data + dataOffset;
+            const char* end = static_cast<const char*>(memchr(namePtr, '\0', nameLen));
+            member.name.assign(namePtr, end ? end : namePtr + nameLen);
+            member.offset += nameLen;
+            member.size -= nameLen;
+            if (member.name.compare(0, 9, "__.SYMDEF") == 0) {
+                index = data + member.offset;
+                indexSize = member.size;
+                indexBsd = true;
+                indexWide = member.name.compare(0, 12, "__.SYMDEF_64") == 0;
+            } else {
+                member.index = static_cast<uint32_t>(_members.size());
+                _members.push_back(std::move(member));
+            }
+        } else if (rawName.size() > 1 && rawName[0] == '/') {
+            // GNU: "/<offset>" refers to the long name table
+            uint64_t nameOffset = 0;
+            if (!longNames || !parseDecimal(rawName.data() + 1, rawName.size() - 1, nameOffset) ||
+                nameOffset >= longNamesSize) {
+                setError("MiniArchive error: invalid long name reference at offset " + std::to_string(pos));
+                return;
+            }
+            const char* namePtr = longNames + nameOffset;
+            const char* end = static_cast<const char*>(memchr(namePtr, '\n', longNamesSize - nameOffset));
+            member.name.assign(namePtr, end ? end : longNames + longNamesSize);
+            if (!member.name.empty() && member.name.back() == '/') member.name.pop_back();
+            member.index = static_cast<uint32_t>(_members.size());
+            _members.push_back(std::move(member));
+        } else {
+            if (!rawName.empty() && rawName.back() == '/') rawName.pop_back();
+            member.name = rawName;
+            member.index = static_cast<uint32_t>(_members.size());
+            _members.push_back(std::move(member));
+        }
+
+        pos = dataOffset + size;
+        pos += pos & 1; // members are 2-byte aligned
+    }
+
+    if (index) {
+        if (indexBsd) parseBsdSymbolIndex(index, indexSize, indexWide);
+        else parseGnuSymbolIndex(index, indexSize, indexWide);
+    }
+
+    _valid = true;
+}
+
+/**
+ * @brief Parse the GNU symbol index (`/` or `/SYM64/` member).
+ * @param data Start of the index member data.
+ * @param size Size of the index member data.
+ * @param wide true for the 64-bit `/SYM64/` variant.
+ */
+void MiniArchive::parseGnuSymbolIndex(const char* data, uint64_t size, bool wide) {
+    const size_t width = wide ? 8 : 4;
+    if (size < width) return;
+    uint64_t count = readBigEndian(data, width);
+    if (count > (size - width) / width) return;
+
+    const char* offsets = data + width;
+    const char* names = offsets + count * width;
+    const char* end = data + size;
+    _symbolIndex.reserve(count);
+    for (uint64_t i = 0; i < count && names < end; ++i) {
+        const char* nul = static_cast<const char*>(memchr(names, '\0', end - names));
+        if (!nul) nul = end;
+        addIndexEntry(std::string_view(names, nul - names), readBigEndian(offsets + i * width, width));
+        names = nul + 1;
+    }
+}
+
+/**
+ * @brief Parse the BSD symbol index (`__.SYMDEF` member).
+ * @param data Start of the index member data.
+ * @param size Size of the index member data.
+ * @param wide true for the 64-bit `__.SYMDEF_64` variant.
+ */
+void MiniArchive::parseBsdSymbolIndex(const char* data, uint64_t size, bool wide) {
+    const size_t width = wide ? 8 : 4;
+    if (size < width) return;
+    uint64_t ranlibSize = readLittleEndian(data, width);
+    if (ranlibSize > size - width || size - width - ranlibSize < width) return;
+
+    const char* ranlibs = data + width;
+    uint64_t strSize = readLittleEndian(ranlibs + ranlibSize, width);
+    const char* strtab = ranlibs + ranlibSize + width;
+    if (strSize > size - 2 * width - ranlibSize) return;
+
+    uint64_t count = ranlibSize / (2 * width);
+    _symbolIndex.reserve(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t strx = readLittleEndian(ranlibs + i * 2 * width, width);
+        uint64_t off = readLittleEndian(ranlibs + i * 2 * width + width, width);
+        if (strx >= strSize) continue;
+        const char* name = strtab + strx;
+        const char* nul = static_cast<const char*>(memchr(name, '\0', strSize - strx));
+        addIndexEntry(std::string_view(name, (nul ? nul : strtab + strSize) - name), off);
+    }
+}
+
+/**
+ * @brief Record an index entry referring to a member header offset.
+ * @param name         Symbol name, viewing the index member in the mapping.
+ * @param headerOffset Offset of the defining member's header.
+ */
+void MiniArchive::addIndexEntry(std::string_view name, uint64_t headerOffset) {
+    auto it = std::lower_bound(_members.begin(), _members.end(), headerOffset,
+        [](const ArchiveMember& m, uint64_t off) { return m.headerOffset < off; });
+    if (it == _members.end() || it->headerOffset != headerOffset) return;
+
+    // Like the linker, the first member defining a symbol wins; the key views
+    // the mapping, which lives as long as the archive
+    _memberBySymbol.emplace(name, it->index);
+    _symbolIndex.push_back({std::string(name), it->index});
+}
+
+} // namespace minielf
@@ -1,52 +1,790 @@
 #include "minielf/MiniELF.hpp"
+#include "minielf/ByteSource.hpp"
+#include "Xxh64.hpp"
 #include <iostream>
 #include <fstream>
 #include <vector>
 #include <algorithm>
 #include <string.h>
+#include <system_error>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 
 namespace minielf {
 
+namespace {
+
+/**
+ * @brief Select symbols with size in [minSize, maxSize] from a span ordered by decreasing size.
+ */
+SymbolSpan sliceBySize(SymbolSpan syms, uint64_t minSize, uint64_t maxSize) {
+    auto first = std::partition_point(syms.begin(), syms.end(),
+        [maxSize](const Symbol* sym) { return sym->size > maxSize; });
+    auto last = std::partition_point(first, syms.end(),
+        [minSize](const Symbol* sym) { return sym->size >= minSize; });
+    return SymbolSpan(first, last);
+}
+
+/**
+ * @brief Parse one overlay line: "ADDRESS SIZE [TYPE] name" with hex numbers.
+ * @return false if the line is malformed.
+ */
+bool parseOverlayLine(const char* line, const char* end, bool withType, Symbol& out) {
+    const char* p = line;
+    auto field = [&](const char*& begin, const char*& stop) {
+        while (p < end && (*p == ' ' || *p == '\t')) ++p;
+        begin = p;
+        while (p < end && *p != ' ' && *p != '\t') ++p;
+        stop = p;
+        return begin != stop;
+    };
+    auto hex = [](const char* begin, const char* stop, uint64_t& value) {
+        if (stop - begin > 2 && begin[0] == '0' && (begin[1] == 'x' || begin[1] == 'X')) begin += 2;
+        if (begin == stop || stop - begin > 16) return false;
+        value = 0;
+        for (; begin != stop; ++begin) {
+            char c = *begin;
+            int digit = c >= '0' && c <= '9' ? c - '0'
+                      : c >= 'a' && c <= 'f' ? c - 'a' + 10
+                      : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+            if (digit < 0) return false;
+            value = (value << 4) | static_cast<uint64_t>(digit);
+        }
+        return true;
+    };
+
+    const char *b, *e;
+    if (!field(b, e) || !hex(b, e, out.address)) return false;
+    if (!field(b, e) || !hex(b, e, out.size)) return false;
+    out.type = SymbolType::FUNC;
+    if (withType) {
+        if (!field(b, e)) return false;
+        const std::string type(b, e);
+        out.type = type == "FUNC" ? SymbolType::FUNC
+                 : type == "OBJECT" ? SymbolType::OBJECT
+                 : type == "NOTYPE" ? SymbolType::NOTYPE
+                 : type == "COMMON" ? SymbolType::COMMON
+                 : type == "TLS" ? SymbolType::TLS : SymbolType::UNKNOWN;
+    }
+    // The name is the rest of the line and may contain spaces
+    while (p < end && (*p == ' ' || *p == '\t')) ++p;
+    while (end > p && (end[-1] == '\r' || end[-1] == ' ')) --end;
+    if (p == end) return false;
+    out.name.assign(p, end);
+    return true;
+}
+
+/**
+ * @brief Find the NT_GNU_BUILD_ID note in a note section or segment.
+ * @param notes   Note data.
+ * @param size    Size of the note data in bytes.
+ * @param buildId Receives the build ID.
+ * @return true if the note was found, false otherwise.
+ */
+bool findBuildId(const char* notes, size_t size, std::vector<uint8_t>& buildId) {
+    // Each note: namesz, descsz, type, then name and desc padded to 4 bytes
+    size_t pos = 0;
+    while (pos + 12 <= size) {
+        uint32_t namesz, descsz, type;
+        memcpy(&namesz, notes + pos, 4);
+        memcpy(&descsz, notes + pos + 4, 4);
+        memcpy(&type, notes + pos + 8, 4);
+        size_t name = pos + 12;
+        size_t desc = name + ((static_cast<size_t>(namesz) + 3) & ~size_t(3));
+        size_t next = desc + ((static_cast<size_t>(descsz) + 3) & ~size_t(3));
+        if (desc > size || desc + descsz > size) break;
+        if (type == 3 /* NT_GNU_BUILD_ID */ && namesz == 4 && memcmp(notes + name, "GNU", 4) == 0) {
+            buildId.assign(notes + desc, notes + desc + descsz);
+            return true;
+        }
+        pos = next;
+    }
+    return false;
+}
+
+/**
+ * @brief Node of a max-Cartesian tree over the entry ends of an address index.
+ *
+ * The parent of an entry is the nearest earlier entry with a greater end, so
+ * ends grow along parent links and the left subtree of an entry holds the
+ * entries between its parent and itself, none of which ends later.
+ */
+struct EndNode {
+    static constexpr uint32_t none = UINT32_MAX;
+    uint32_t parent = none; ///< Nearest earlier entry with a greater end
+    uint32_t jump = none;   ///< Skew-binary jump pointer along parent links
+    uint32_t depth = 0;     ///< Number of parent links up to a root
+    uint32_t left = none;   ///< Entry with the greatest end between the parent and this entry
+    uint32_t right = none;  ///< Entry with the greatest end between this entry and the next greater one
+};
+
+} // namespace
+
+/**
+ * @brief Parsed state of an ELF image, shared by the MiniELF handles copied from
+ * the one that parsed it.
+ *
+ * Once shared, an image is only read: the lookup indexes are built lazily
+ * under lookupMutex and are part of its logical state, everything else is
+ * written while a single handle owns the image (parsing, overlays, releasing
+ * indexes).
+ */
+struct MiniELF::Image {
+    std::string filepath;                    ///< Path to the ELF file
+    uint64_t fileSize = 0;                   ///< Size of the ELF image in bytes
+    uint32_t programHeaderCount = 0;         ///< Program header count (PN_XNUM resolved)
+    bool valid = false;                      ///< ELF file validity flag
+    std::vector<Section> sections;           ///< Parsed sections
+    std::vector<Symbol> symbols;             ///< Parsed symbols
+    Elf64_Ehdr elfHeader{};                  ///< ELF header structure
+    std::vector<Elf64_Shdr> sectionHeaders;  ///< Section headers
+    std::vector<Elf64_Phdr> programHeaders;  ///< Program headers
+    std::vector<char> sectionStringTableRaw; ///< Raw section string table
+    std::vector<char> symbolStringTableRaw;  ///< Raw symbol string table
+    std::vector<uint32_t> symbolNameOffsets; ///< st_name of each symbol
+    std::vector<uint8_t> buildId;            ///< GNU build ID
+    ParseStage failureStage = ParseStage::Header; ///< Stage of failure during parsing
+
+    std::deque<Symbol> overlaySymbols;                        ///< Overlay symbols (stable addresses)
+    std::unordered_map<const Symbol*, int> overlayPriorities; ///< Priority of each overlay symbol
+    std::unordered_map<std::string, uint64_t> overlayFileOffsets; ///< Bytes consumed per overlay file
+
+    mutable std::vector<const Symbol*> symbolsByName;      ///< Named symbols sorted by name, same names contiguous
+    /// Name -> (first, count) in symbolsByName; keys view Symbol::name, so
+    /// lookups by std::string_view need no allocation
+    mutable std::unordered_map<std::string_view, std::pair<uint32_t, uint32_t>> symbolByName;
+    mutable std::vector<const Symbol*> symbolsSortedByAddr;
+    mutable std::vector<const Section*> sectionsSortedByAddr;
+    mutable std::unordered_map<std::string_view, const Section*> sectionByName; ///< Keys view Section::name
+    mutable std::vector<const Symbol*> symbolsBySection;   ///< Symbols grouped by section, then by offset
+    mutable std::vector<uint32_t> sectionSymbolOffsets;    ///< Start of each section's group in symbolsBySection
+    mutable std::vector<EndNode> symbolEndTree;  ///< Max-tree of symbol ends over symbolsSortedByAddr
+    mutable std::vector<EndNode> sectionEndTree; ///< Max-tree of section ends over sectionsSortedByAddr
+    mutable std::vector<const Symbol*> symbolsBySize;        ///< All symbols, largest first
+    mutable std::vector<const Symbol*> symbolsByTypeAndSize; ///< Symbols by type, then largest first
+    mutable std::atomic<uint8_t> builtIndexes{0};          ///< LookupIndex flags of the built indexes
+    mutable std::mutex lookupMutex;                        ///< Serializes index builds
+    IndexWarming indexWarming = IndexWarming::OnFirstUse;
+    std::thread indexWarmer;                               ///< Background index build, joined on destruction
+
+    /**
+     * @brief Create an empty image.
+     * @param path Path or name of the image.
+     */
+    explicit Image(std::string path) : filepath(std::move(path)) {}
+
+    /**
+     * @brief Copy the parsed data and overlays of an image; indexes are rebuilt on use.
+     * @param other Image to copy.
+     */
+    Image(const Image& other);
+
+    Image& operator=(const Image&) = delete;
+
+    /**
+     * @brief Wait for a background index build to finish.
+     */
+    ~Image() {
+        if (indexWarmer.joinable()) indexWarmer.join();
+    }
+
+    /**
+     * @brief Build one lookup index unless it is already built. Thread-safe.
+     * @param index Index to build (a single LookupIndex flag).
+     */
+    void ensureIndex(LookupIndex index) const;
+
+    /**
+     * @brief Check whether lookup indexes have been built.
+     * @param which Indexes to check.
+     * @return true if all of them are built.
+     */
+    bool areIndexesReady(LookupIndex which) const;
+
+    /**
+     * @brief Build lookup indexes now, or wait for their build to finish.
+     * @param which Indexes to build.
+     */
+    void waitForIndexes(LookupIndex which) const;
+
+    /**
+     * @brief Free lookup indexes; they are rebuilt on their next use.
+     * @param which Indexes to free.
+     */
+    void releaseIndexes(LookupIndex which);
+
+    /**
+     * @brief Build the symbol name index (symbolsByName, symbolByName).
+     */
+    void buildNameIndex() const;
+
+    /**
+     * @brief Build the address orders of symbols and sections and their prefix maxima.
+     */
+    void buildAddressIndex() const;
+
+    /**
+     * @brief Build the section name map and the per-section symbol groups.
+     */
+    void buildSectionIndex() const;
+
+    /**
+     * @brief Build the size-ordered symbol indexes.
+     */
+    void buildSizeIndex() const;
+
+    /**
+     * @brief Get the priority of a symbol in the address index.
+     * @param sym Symbol from the symbol table or an overlay.
+     * @return 0 for symbol table entries, the batch priority for overlays.
+     */
+    int overlayPriority(const Symbol* sym) const;
+};
+
+/**
+ * @brief Copy the parsed data and overlays of an image.
+ *
+ * Overlay priorities are keyed by symbol address, so they are re-keyed to the
+ * copied overlay symbols. Indexes are not copied; they hold pointers into the
+ * original and are rebuilt on first use.
+ * @param other Image to copy.
+ */
+MiniELF::Image::Image(const Image& other)
+    : filepath(other.filepath), fileSize(other.fileSize), programHeaderCount(other.programHeaderCount),
+      valid(other.valid), sections(other.sections), symbols(other.symbols), elfHeader(other.elfHeader),
+      sectionHeaders(other.sectionHeaders), programHeaders(other.programHeaders),
+      sectionStringTableRaw(other.sectionStringTableRaw), symbolStringTableRaw(other.symbolStringTableRaw),
+      symbolNameOffsets(other.symbolNameOffsets), buildId(other.buildId), failureStage(other.failureStage),
+      overlaySymbols(other.overlaySymbols), overlayFileOffsets(other.overlayFileOffsets) {
+    auto copied = overlaySymbols.begin();
+    for (const auto& sym : other.overlaySymbols)
+        overlayPriorities.emplace(&*copied++, other.overlayPriorities.find(&sym)->second);
+}
+
 /**
  * @brief Construct a MiniELF object and parse the ELF file.
  * @param filepath Path to the ELF file.
  */
-MiniELF::MiniELF(const std::string& filepath) : _filepath(filepath) {
-    parse();
-    // Prepare sorted pointers for fast lookup
-    for (const auto& sym : _symbols) _symbolsSortedByAddr.push_back(&sym);
-    for (const auto& sec : _sections) _sectionsSortedByAddr.push_back(&sec);
-    _lookupBuilt = false;
+MiniELF::MiniELF(const std::string& filepath) : _image(std::make_shared<Image>(filepath)) {
+    FileByteSource file(_image->filepath);
+    if (!file.isOpen()) {
+        setError("MiniELF error: failed to open file: " + _image->filepath);
+        return;
+    }
+    init(file);
+}
+
+/**
+ * @brief Construct a MiniELF object and parse the ELF file with options.
+ * @param filepath Path to the ELF file.
+ * @param options  Additional parsing work.
+ */
+MiniELF::MiniELF(const std::string& filepath, const ParseOptions& options) : _image(std::make_shared<Image>(filepath)) {
+    FileByteSource file(_image->filepath);
+    if (!file.isOpen()) {
+        setError("MiniELF error: failed to open file: " + _image->filepath);
+        return;
+    }
+    init(file);
+    if (_image->valid) computeSectionHashes(file, options);
+    startIndexWarming(options.indexWarming);
+}
+
+/**
+ * @brief Construct a MiniELF object and parse an ELF image held in memory.
+ * @param data Pointer to the start of the ELF image.
+ * @param size Size of the image in bytes.
+ * @param name Name reported in diagnostics.
+ */
+MiniELF::MiniELF(const void* data, size_t size, const std::string& name) : _image(std::make_shared<Image>(name)) {
+    init(MemoryByteSource(data, size));
+}
+
+/**
+ * @brief Construct a MiniELF object and parse an ELF image from a byte source.
+ * @param source Source of the image bytes; only used during construction.
+ * @param name   Name reported in diagnostics.
+ */
+MiniELF::MiniELF(const ByteSource& source, const std::string& name) : _image(std::make_shared<Image>(name)) {
+    init(source);
+}
+
+/**
+ * @brief Construct a MiniELF object and parse an ELF image from a byte source with options.
+ * @param source  Source of the image bytes; only used during construction.
+ * @param name    Name reported in diagnostics.
+ * @param options Additional parsing work.
+ */
+MiniELF::MiniELF(const ByteSource& source, const std::string& name, const ParseOptions& options)
+    : _image(std::make_shared<Image>(name)) {
+    init(source);
+    if (_image->valid) computeSectionHashes(source, options);
+    startIndexWarming(options.indexWarming);
 }
 
+/**
+ * @brief Construct a MiniELF object and parse an ELF image with a given layout.
+ * @param source      Source of the image bytes; only used during construction.
+ * @param name        Name reported in diagnostics.
+ * @param layout      Layout of the source.
+ * @param loadAddress Runtime address of the first byte of a loaded image (0 if unknown).
+ */
+MiniELF::MiniELF(const ByteSource& source, const std::string& name, ImageLayout layout,
+                 uint64_t loadAddress) : _image(std::make_shared<Image>(name)) {
+    init(source, layout, loadAddress);
+}
+
+/**
+ * @brief Take over the parsed image of another handle.
+ * @param other Handle to move from; left holding an empty, invalid image.
+ */
+MiniELF::MiniELF(MiniELF&& other) noexcept
+    : _image(std::exchange(other._image, emptyImage())),
+      _unsafeAccessEnabled(std::exchange(other._unsafeAccessEnabled, false)),
+      _lastError(std::move(other._lastError)) {
+    other._lastError.clear();
+}
 
 /**
- * @brief Build fast lookup tables for symbols and sections.
+ * @brief Take over the parsed image of another handle.
+ * @param other Handle to move from; left holding an empty, invalid image.
+ * @return Reference to this handle.
+ */
+MiniELF& MiniELF::operator=(MiniELF&& other) noexcept {
+    if (this != &other) {
+        _image = std::exchange(other._image, emptyImage());
+        _unsafeAccessEnabled = std::exchange(other._unsafeAccessEnabled, false);
+        _lastError = std::move(other._lastError);
+        other._lastError.clear();
+    }
+    return *this;
+}
+
+/**
+ * @brief Get an empty image for moved-from handles.
  *
- * This method initializes and sorts internal data structures to enable efficient
- * symbol and section lookups by name and address. It constructs a hash map for
- * symbol name lookup and sorts vectors of pointers for binary search by address.
- * The lookup tables are built only once and reused for subsequent queries.
- */
-void MiniELF::buildLookups() const {
-    if (_lookupBuilt) return;
-    _symbolByName.clear();
-    for (const auto& sym : _symbols) {
-        if (!sym.name.empty()) { 
-            _symbolByName[sym.name] = &sym;
+ * One empty image is shared by all moved-from handles, so moving never
+ * allocates; it is never modified since it always has several owners.
+ * @return Shared pointer to the empty image.
+ */
+std::shared_ptr<MiniELF::Image> MiniELF::emptyImage() {
+    static const std::shared_ptr<Image> empty = std::make_shared<Image>(std::string());
+    return empty;
+}
+
+/**
+ * @brief Get the image for modification, copying it first if other handles share it.
+ *
+ * Only this handle can add owners to an image it owns alone (by being copied),
+ * so a use count of one cannot grow while the caller modifies the image.
+ * @return Reference to an image owned by this handle only.
+ */
+MiniELF::Image& MiniELF::mutableImage() {
+    if (_image.use_count() > 1) _image = std::make_shared<Image>(*_image);
+    return *_image;
+}
+
+/**
+ * @brief Parse an image.
+ * @param source      Source of the image bytes.
+ * @param layout      Layout of the source.
+ * @param loadAddress Runtime address of a loaded image (0 if unknown).
+ */
+void MiniELF::init(const ByteSource& source, ImageLayout layout, uint64_t loadAddress) {
+    if (layout == ImageLayout::Loaded) {
+        parseLoaded(source, loadAddress);
+    } else {
+        parse(source);
+    }
+}
+
+
+/**
+ * @brief Hash the contents of the sections selected by the options into Section::hash.
+ *
+ * Sections are hashed in place when the source provides views, otherwise
+ * streamed through a fixed-size buffer, so only the selected sections are
+ * read. Sections extending past the end of the image are not hashed.
+ * @param source  Source of the image bytes.
+ * @param options Parse options naming the sections (hashSections, hashAllSections).
+ */
+void MiniELF::computeSectionHashes(const ByteSource& source, const ParseOptions& options) {
+    const auto& names = options.hashSections;
+    if (names.empty() && !options.hashAllSections) return;
+    std::vector<char> buffer;
+    for (auto& sec : _image->sections) {
+        if (sec.hash) continue;
+        if (!options.hashAllSections && std::find(names.begin(), names.end(), sec.name) == names.end()) continue;
+        const Elf64_Shdr& sh = _image->sectionHeaders[sec.index];
+        if (sh.sh_type == 0 /* SHT_NULL */ || sh.sh_type == 8 /* SHT_NOBITS */ || sh.sh_offset > _image->fileSize ||
+            sh.sh_size > _image->fileSize - sh.sh_offset) continue;
+
+        const size_t size = static_cast<size_t>(sh.sh_size);
+        if (const char* data = source.view(sh.sh_offset, size)) {
+            sec.hash = detail::Xxh64::hash(data, size);
+            continue;
+        }
+        buffer.resize(1 << 20);
+        detail::Xxh64 hash;
+        size_t done = 0;
+        while (done < size) {
+            const size_t chunk = std::min(buffer.size(), size - done);
+            if (source.readAt(sh.sh_offset + done, buffer.data(), chunk) != chunk) break;
+            hash.update(buffer.data(), chunk);
+            done += chunk;
         }
+        if (done == size) sec.hash = hash.digest();
     }
-    // Add section name lookup
-    _sectionByName.clear();
-    for (const auto& sec : _sections) {
-        _sectionByName[sec.name] = &sec;
+}
+
+/**
+ * @brief Hash the contents of named sections into Section::hash after parsing.
+ * @param source Source of the bytes the file was parsed from.
+ * @param names  Names of the sections to hash.
+ * @return false if the file is invalid or the source does not match its size.
+ */
+bool MiniELF::hashSections(const ByteSource& source, const std::vector<std::string>& names) {
+    if (!_image->valid || source.size() != _image->fileSize) return false;
+    const bool pending = std::any_of(_image->sections.begin(), _image->sections.end(), [&names](const Section& sec) {
+        return !sec.hash && std::find(names.begin(), names.end(), sec.name) != names.end();
+    });
+    if (!pending) return true;
+    mutableImage();
+    ParseOptions options;
+    options.hashSections = names;
+    computeSectionHashes(source, options);
+    return true;
+}
+
+namespace {
+
+/**
+ * @brief Collect the entries starting before an address that reach past it.
+ *
+ * The last such entry is found along parent links with jump pointers, in
+ * O(log n); the others are its ancestors and the parts of their left
+ * subtrees that reach past the address, so each visited node is reported or
+ * is a child of a reported one.
+ * @param index Entries sorted by address.
+ * @param tree  End tree over the index.
+ * @param count Number of entries starting before lo.
+ * @param lo    Address to reach past.
+ * @return Matching entries, in address order.
+ */
+template <typename T>
+std::vector<const T*> findStraddlers(const std::vector<const T*>& index, const std::vector<EndNode>& tree,
+                                     size_t count, uint64_t lo) {
+    constexpr uint32_t none = EndNode::none;
+    auto reaches = [&](uint32_t i) { return AddressRange<T>::entryEnd(*index[i]) > lo; };
+    uint32_t last = count ? static_cast<uint32_t>(count - 1) : none;
+    while (last != none && !reaches(last)) {
+        // Ends grow along parent links: jump while the target still falls short
+        const uint32_t jump = tree[last].jump;
+        last = jump != none && !reaches(jump) ? jump : tree[last].parent;
     }
-    // Sort symbols and sections by address for binary search
-    std::sort(_symbolsSortedByAddr.begin(), _symbolsSortedByAddr.end(),
-        [](const Symbol* a, const Symbol* b) { return a->address < b->address; });
-    std::sort(_sectionsSortedByAddr.begin(), _sectionsSortedByAddr.end(),
+    std::vector<uint32_t> ancestors;
+    for (uint32_t node = last; node != none; node = tree[node].parent) ancestors.push_back(node);
+
+    std::vector<const T*> result;
+    std::vector<uint32_t> pending;
+    for (auto it = ancestors.rbegin(); it != ancestors.rend(); ++it) {
+        // In-order walk of the left subtree, pruning subtrees that end at or before lo
+        uint32_t node = tree[*it].left;
+        while (true) {
+            while (node != none && reaches(node)) {
+                pending.push_back(node);
+                node = tree[node].left;
+            }
+            if (pending.empty()) break;
+            node = pending.back();
+            pending.pop_back();
+            result.push_back(index[node]);
+            node = tree[node].right;
+        }
+        result.push_back(index[*it]);
+    }
+    return result;
+}
+
+/**
+ * @brief Locate the window [lo, hi) in an address index.
+ * @param index Entries sorted by address.
+ * @param tree  End tree over the index.
+ */
+template <typename T>
+AddressRange<T> findRange(const std::vector<const T*>& index, const std::vector<EndNode>& tree,
+                          uint64_t lo, uint64_t hi) {
+    if (lo >= hi) return {};
+    auto startsBefore = [](const T* entry, uint64_t address) { return entry->address < address; };
+    const T* const* base = index.data();
+    const T* const* first = base + (std::lower_bound(index.begin(), index.end(), lo, startsBefore) - index.begin());
+    const T* const* last = base + (std::lower_bound(index.begin(), index.end(), hi, startsBefore) - index.begin());
+    return AddressRange<T>(findStraddlers(index, tree, first - base, lo), first, last);
+}
+
+/**
+ * @brief Build the max-tree of entry ends over an address index.
+ *
+ * A stack of entries with decreasing ends yields each parent and left child;
+ * the right child of an entry is final once a later entry pops it.
+ */
+template <typename T>
+void buildEndTree(const std::vector<const T*>& index, std::vector<EndNode>& tree) {
+    tree.assign(index.size(), EndNode());
+    std::vector<uint32_t> stack;
+    for (uint32_t i = 0; i < index.size(); ++i) {
+        const uint64_t end = AddressRange<T>::entryEnd(*index[i]);
+        EndNode& node = tree[i];
+        while (!stack.empty() && AddressRange<T>::entryEnd(*index[stack.back()]) <= end) {
+            node.left = stack.back();
+            stack.pop_back();
+        }
+        if (!stack.empty()) {
+            const uint32_t parent = stack.back();
+            tree[parent].right = i;
+            node.parent = parent;
+            node.depth = tree[parent].depth + 1;
+            // Jump twice as far as the parent does when its two jumps are equally long
+            const uint32_t jump = tree[parent].jump;
+            const bool skew = jump != EndNode::none && tree[jump].jump != EndNode::none &&
+                tree[parent].depth - tree[jump].depth == tree[jump].depth - tree[tree[jump].jump].depth;
+            node.jump = skew ? tree[jump].jump : parent;
+        }
+        stack.push_back(i);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Build one lookup index unless it is already built.
+ *
+ * Each index is built independently on first use, so a workload only pays
+ * for the structures it queries. Thread-safe: concurrent callers build an
+ * index once and wait for each other.
+ * @param index Index to build (a single LookupIndex flag).
+ */
+void MiniELF::Image::ensureIndex(LookupIndex index) const {
+    const uint8_t bit = static_cast<uint8_t>(index);
+    if (builtIndexes.load(std::memory_order_acquire) & bit) return;
+    std::lock_guard<std::mutex> lock(lookupMutex);
+    if (builtIndexes.load(std::memory_order_relaxed) & bit) return;
+    switch (index) {
+    case LookupIndex::Names:     buildNameIndex(); break;
+    case LookupIndex::Addresses: buildAddressIndex(); break;
+    case LookupIndex::Sections:  buildSectionIndex(); break;
+    case LookupIndex::Sizes:     buildSizeIndex(); break;
+    default: return;
+    }
+    builtIndexes.fetch_or(bit, std::memory_order_release);
+}
+
+/**
+ * @brief Build the symbol name index.
+ */
+void MiniELF::Image::buildNameIndex() const {
+    // Sort named symbols by name (stable, so duplicates keep table order) and
+    // map each distinct name to its contiguous range
+    symbolsByName.clear();
+    symbolsByName.reserve(symbols.size());
+    for (const auto& sym : symbols) {
+        if (!sym.name.empty()) {
+            symbolsByName.push_back(&sym);
+        }
+    }
+    std::stable_sort(symbolsByName.begin(), symbolsByName.end(),
+        [](const Symbol* a, const Symbol* b) { return a->name < b->name; });
+    symbolByName.clear();
+    symbolByName.reserve(symbolsByName.size());
+    for (uint32_t i = 0, n = static_cast<uint32_t>(symbolsByName.size()); i < n;) {
+        uint32_t j = i + 1;
+        while (j < n && symbolsByName[j]->name == symbolsByName[i]->name) ++j;
+        symbolByName.emplace(symbolsByName[i]->name, std::make_pair(i, j - i));
+        i = j;
+    }
+}
+
+/**
+ * @brief Build the address orders of symbols (overlays included) and sections.
+ */
+void MiniELF::Image::buildAddressIndex() const {
+    // Sort symbols and sections by address for binary search; aliases keep
+    // symbol table order so exports are deterministic, and overlay symbols
+    // follow by priority, then in the order they were added
+    symbolsSortedByAddr.clear();
+    symbolsSortedByAddr.reserve(symbols.size() + overlaySymbols.size());
+    for (const auto& sym : symbols) symbolsSortedByAddr.push_back(&sym);
+    for (const auto& sym : overlaySymbols) symbolsSortedByAddr.push_back(&sym);
+    if (overlaySymbols.empty()) {
+        std::stable_sort(symbolsSortedByAddr.begin(), symbolsSortedByAddr.end(),
+            [](const Symbol* a, const Symbol* b) { return a->address < b->address; });
+    } else {
+        std::stable_sort(symbolsSortedByAddr.begin(), symbolsSortedByAddr.end(),
+            [this](const Symbol* a, const Symbol* b) {
+                if (a->address != b->address) return a->address < b->address;
+                return overlayPriority(a) < overlayPriority(b);
+            });
+    }
+    sectionsSortedByAddr.clear();
+    sectionsSortedByAddr.reserve(sections.size());
+    for (const auto& sec : sections) sectionsSortedByAddr.push_back(&sec);
+    std::sort(sectionsSortedByAddr.begin(), sectionsSortedByAddr.end(),
         [](const Section* a, const Section* b) { return a->address < b->address; });
-    _lookupBuilt = true;
+
+    // Max-trees of entry ends for range queries
+    buildEndTree(symbolsSortedByAddr, symbolEndTree);
+    buildEndTree(sectionsSortedByAddr, sectionEndTree);
+}
+
+/**
+ * @brief Build the section name map and the per-section symbol groups.
+ */
+void MiniELF::Image::buildSectionIndex() const {
+    sectionByName.clear();
+    for (const auto& sec : sections) {
+        sectionByName[sec.name] = &sec;
+    }
+
+    // Group symbols by their defining section (counting sort), then order each
+    // group by address so section-relative queries can binary search it
+    sectionSymbolOffsets.assign(sections.size() + 1, 0);
+    for (const auto& sym : symbols) {
+        if (sym.sectionIndex != 0 && sym.sectionIndex < sections.size())
+            ++sectionSymbolOffsets[sym.sectionIndex + 1];
+    }
+    for (size_t i = 1; i < sectionSymbolOffsets.size(); ++i)
+        sectionSymbolOffsets[i] += sectionSymbolOffsets[i - 1];
+    symbolsBySection.resize(sectionSymbolOffsets.back());
+    std::vector<uint32_t> next(sectionSymbolOffsets.begin(), sectionSymbolOffsets.end() - 1);
+    for (const auto& sym : symbols) {
+        if (sym.sectionIndex != 0 && sym.sectionIndex < sections.size())
+            symbolsBySection[next[sym.sectionIndex]++] = &sym;
+    }
+    for (size_t i = 0; i < sections.size(); ++i) {
+        std::stable_sort(symbolsBySection.begin() + sectionSymbolOffsets[i],
+                         symbolsBySection.begin() + sectionSymbolOffsets[i + 1],
+            [](const Symbol* a, const Symbol* b) { return a->address < b->address; });
+    }
+}
+
+/**
+ * @brief Get the priority of a symbol in the address index.
+ * @param sym Symbol from the symbol table or an overlay.
+ * @return 0 for symbol table entries, the batch priority for overlays.
+ */
+int MiniELF::Image::overlayPriority(const Symbol* sym) const {
+    if (sym >= symbols.data() && sym < symbols.data() + symbols.size()) return 0;
+    return overlayPriorities.find(sym)->second;
+}
+
+/**
+ * @brief Start building the lookup indexes in the background if requested.
+ *
+ * The thread works on the image rather than on this handle, so the handle may
+ * be copied or moved while the build runs.
+ * @param warming When to build the indexes.
+ */
+void MiniELF::startIndexWarming(IndexWarming warming) {
+    _image->indexWarming = warming;
+    if (warming == IndexWarming::OnFirstUse || !_image->valid) return;
+    try {
+        const Image* image = _image.get();
+        _image->indexWarmer = std::thread([image] { image->waitForIndexes(LookupIndex::Lookups); });
+    } catch (const std::system_error&) {
+        // No thread available: build on first use instead
+        _image->indexWarming = IndexWarming::OnFirstUse;
+    }
+}
+
+/**
+ * @brief Check whether point lookups should scan linearly for now.
+ * @param index Index the lookup needs.
+ * @return true while a Fallback background build of that index is pending.
+ */
+bool MiniELF::useFallbackLookups(LookupIndex index) const {
+    return _image->indexWarming == IndexWarming::Fallback && !_image->areIndexesReady(index);
+}
+
+/**
+ * @brief Check whether lookup indexes have been built.
+ * @param which Indexes to check.
+ * @return true if all of them are built, false while any is pending.
+ */
+bool MiniELF::areIndexesReady(LookupIndex which) const {
+    return _image->areIndexesReady(which);
+}
+
+/**
+ * @brief Check whether lookup indexes have been built.
+ * @param which Indexes to check.
+ * @return true if all of them are built.
+ */
+bool MiniELF::Image::areIndexesReady(LookupIndex which) const {
+    const uint8_t bits = static_cast<uint8_t>(which);
+    return (builtIndexes.load(std::memory_order_acquire) & bits) == bits;
+}
+
+/**
+ * @brief Build lookup indexes now, or wait for the background build.
+ * @param which Indexes to build.
+ */
+void MiniELF::waitForIndexes(LookupIndex which) const {
+    _image->waitForIndexes(which);
+}
+
+/**
+ * @brief Build lookup indexes now, or wait for their build to finish.
+ * @param which Indexes to build.
+ */
+void MiniELF::Image::waitForIndexes(LookupIndex which) const {
+    for (LookupIndex index : {LookupIndex::Addresses, LookupIndex::Names, LookupIndex::Sections, LookupIndex::Sizes}) {
+        if (static_cast<uint8_t>(which) & static_cast<uint8_t>(index)) ensureIndex(index);
+    }
+}
+
+/**
+ * @brief Free lookup indexes unless other handles share the image.
+ * @param which Indexes to free.
+ */
+void MiniELF::releaseIndexes(LookupIndex which) {
+    if (_image.use_count() == 1) _image->releaseIndexes(which);
+}
+
+/**
+ * @brief Free lookup indexes; they are rebuilt on their next use.
+ * @param which Indexes to free.
+ */
+void MiniELF::Image::releaseIndexes(LookupIndex which) {
+    if (indexWarmer.joinable()) indexWarmer.join();
+    // The background build is over; released indexes are rebuilt on first use
+    // rather than answered by scans that miss overlay symbols
+    indexWarming = IndexWarming::OnFirstUse;
+    const uint8_t bits = static_cast<uint8_t>(which);
+    auto release = [](auto& container) { std::decay_t<decltype(container)>().swap(container); };
+    if (bits & static_cast<uint8_t>(LookupIndex::Names)) {
+        release(symbolsByName);
+        release(symbolByName);
+    }
+    if (bits & static_cast<uint8_t>(LookupIndex::Addresses)) {
+        release(symbolsSortedByAddr);
+        release(sectionsSortedByAddr);
+        release(symbolEndTree);
+        release(sectionEndTree);
+    }
+    if (bits & static_cast<uint8_t>(LookupIndex::Sections)) {
+        release(sectionByName);
+        release(symbolsBySection);
+        release(sectionSymbolOffsets);
+    }
+    if (bits & static_cast<uint8_t>(LookupIndex::Sizes)) {
+        release(symbolsBySize);
+        release(symbolsByTypeAndSize);
+    }
+    builtIndexes.fetch_and(static_cast<uint8_t>(~bits), std::memory_order_release);
 }
 
 /**
@@ -54,23 +792,23 @@ void MiniELF::buildLookups() const {
  * @return true if valid, false otherwise.
  */
 bool MiniELF::isValid() const {
-    return _valid || _unsafeAccessEnabled;
+    return _image->valid || _unsafeAccessEnabled;
 }
 
 /**
  * @brief Get the list of ELF sections.
- * @return Vector of Section objects.
+ * @return Reference to the vector of Section objects.
  */
-std::vector<Section> MiniELF::getSections() const {
-    return _sections;
+const std::vector<Section>& MiniELF::getSections() const {
+    return _image->sections;
 }
 
 /**
  * @brief Get the list of ELF symbols.
- * @return Vector of Symbol objects.
+ * @return Reference to the vector of Symbol objects.
  */
-std::vector<Symbol> MiniELF::getSymbols() const {
-    return _symbols;
+const std::vector<Symbol>& MiniELF::getSymbols() const {
+    return _image->symbols;
 }
 
 /**
@@ -79,17 +817,28 @@ std::vector<Symbol> MiniELF::getSymbols() const {
  * @return Pointer to Symbol if found, nullptr otherwise.
  */
 const Symbol* MiniELF::getSymbolByAddress(uint64_t addr) const {
-    buildLookups();
-    auto it = std::lower_bound(
-        _symbolsSortedByAddr.begin(), _symbolsSortedByAddr.end(), addr,
-        [](const Symbol* sym, uint64_t address) {
-            return sym->address + sym->size <= address;
+    if (isRelocatable()) return nullptr;
+    if (useFallbackLookups(LookupIndex::Addresses)) {
+        // Covering symbol starting last (then last in table order); the index
+        // gives the same answer unless sized symbols nest
+        const Symbol* best = nullptr;
+        for (const auto& sym : _image->symbols) {
+            if (sym.address <= addr && addr < sym.address + sym.size && (!best || sym.address >= best->address))
+                best = &sym;
+        }
+        return best;
+    }
+    _image->ensureIndex(LookupIndex::Addresses);
+    auto it = std::upper_bound(
+        _image->symbolsSortedByAddr.begin(), _image->symbolsSortedByAddr.end(), addr,
+        [](uint64_t address, const Symbol* sym) {
+            return address < sym->address;
         });
-    if (it != _symbolsSortedByAddr.begin()) --it;
-    if (it != _symbolsSortedByAddr.end()) {
-        const Symbol* sym = *it;
-        if (sym->address <= addr && addr < sym->address + sym->size)
-            return sym;
+    // Walk back over zero-sized labels and symbols sharing the same start (aliases)
+    while (it != _image->symbolsSortedByAddr.begin()) {
+        const Symbol* sym = *--it;
+        if (addr < sym->address + sym->size) return sym;
+        if (sym->size != 0 && (it == _image->symbolsSortedByAddr.begin() || (*(it - 1))->address != sym->address)) break;
     }
     return nullptr;
 }
@@ -99,10 +848,27 @@ const Symbol* MiniELF::getSymbolByAddress(uint64_t addr) const {
  * @param name Name of the symbol to search for.
  * @return Pointer to Symbol if found, nullptr otherwise.
  */
-const Symbol* MiniELF::getSymbolByName(const std::string& name) const {
-    buildLookups();
-    auto it = _symbolByName.find(name);
-    return it != _symbolByName.end() ? it->second : nullptr;
+const Symbol* MiniELF::getSymbolByName(std::string_view name) const {
+    if (useFallbackLookups(LookupIndex::Names)) {
+        for (auto it = _image->symbols.rbegin(); it != _image->symbols.rend() && !name.empty(); ++it)
+            if (it->name == name) return &*it;
+        return nullptr;
+    }
+    SymbolSpan matches = getSymbolsByName(name);
+    return matches.empty() ? nullptr : matches[matches.size() - 1];
+}
+
+/**
+ * @brief Find all symbols with a given name.
+ * @param name Name of the symbols to search for.
+ * @return Span of matching symbols in symbol table order (empty if none).
+ */
+SymbolSpan MiniELF::getSymbolsByName(std::string_view name) const {
+    _image->ensureIndex(LookupIndex::Names);
+    auto it = _image->symbolByName.find(name);
+    if (it == _image->symbolByName.end()) return {};
+    const Symbol* const* first = _image->symbolsByName.data() + it->second.first;
+    return SymbolSpan(first, first + it->second.second);
 }
 
 /**
@@ -111,38 +877,223 @@ const Symbol* MiniELF::getSymbolByName(const std::string& name) const {
  * @return Pointer to nearest Symbol if found, nullptr otherwise.
  */
 const Symbol* MiniELF::getNearestSymbol(uint64_t address) const {
-    buildLookups();
+    if (isRelocatable()) return nullptr;
+    if (useFallbackLookups(LookupIndex::Addresses)) {
+        const Symbol* best = nullptr;
+        for (const auto& sym : _image->symbols) {
+            if (sym.address <= address && (!best || sym.address >= best->address)) best = &sym;
+        }
+        return best;
+    }
+    _image->ensureIndex(LookupIndex::Addresses);
     auto it = std::upper_bound(
-        _symbolsSortedByAddr.begin(), _symbolsSortedByAddr.end(), address,
+        _image->symbolsSortedByAddr.begin(), _image->symbolsSortedByAddr.end(), address,
         [](uint64_t address, const Symbol* sym) {
             return address < sym->address;
         });
-    if (it == _symbolsSortedByAddr.begin()) return nullptr;
+    if (it == _image->symbolsSortedByAddr.begin()) return nullptr;
     --it;
     return *it;
 }
 
+/**
+ * @brief Get all symbols ordered by address.
+ * @return Span over the address index.
+ */
+SymbolSpan MiniELF::getSymbolsSortedByAddress() const {
+    _image->ensureIndex(LookupIndex::Addresses);
+    return SymbolSpan(_image->symbolsSortedByAddr.data(),
+                      _image->symbolsSortedByAddr.data() + _image->symbolsSortedByAddr.size());
+}
+
+/**
+ * @brief Get all named symbols ordered by name.
+ * @return Span over the name index.
+ */
+SymbolSpan MiniELF::getSymbolsSortedByName() const {
+    _image->ensureIndex(LookupIndex::Names);
+    return SymbolSpan(_image->symbolsByName.data(), _image->symbolsByName.data() + _image->symbolsByName.size());
+}
+
+/**
+ * @brief Get the symbols intersecting an address window, in address order.
+ * @param lo First address of the window.
+ * @param hi End of the window (exclusive).
+ * @return View over the address index.
+ */
+AddressRange<Symbol> MiniELF::getSymbolsInRange(uint64_t lo, uint64_t hi) const {
+    if (isRelocatable()) return {};
+    _image->ensureIndex(LookupIndex::Addresses);
+    return findRange(_image->symbolsSortedByAddr, _image->symbolEndTree, lo, hi);
+}
+
+/**
+ * @brief Check whether the ELF file is a relocatable object (ET_REL).
+ * @return true if the file is a relocatable object, false otherwise.
+ */
+bool MiniELF::isRelocatable() const {
+    return _image->elfHeader.e_type == 1 /* ET_REL */;
+}
+
+/**
+ * @brief Get all symbols defined in a section, ordered by offset.
+ * @param sectionIndex Index of the section header.
+ * @return Span of symbols (empty if the index is out of range).
+ */
+SymbolSpan MiniELF::getSymbolsInSection(uint32_t sectionIndex) const {
+    if (sectionIndex >= _image->sections.size()) return {};
+    _image->ensureIndex(LookupIndex::Sections);
+    const Symbol* const* base = _image->symbolsBySection.data();
+    return SymbolSpan(base + _image->sectionSymbolOffsets[sectionIndex],
+                      base + _image->sectionSymbolOffsets[sectionIndex + 1]);
+}
+
+/**
+ * @brief Find a symbol covering an offset within a section.
+ * @param sectionIndex Index of the section header.
+ * @param offset       Offset within the section.
+ * @return Pointer to Symbol if found, nullptr otherwise.
+ */
+const Symbol* MiniELF::getSymbolBySectionOffset(uint32_t sectionIndex, uint64_t offset) const {
+    SymbolSpan syms = getSymbolsInSection(sectionIndex);
+    uint64_t addr = isRelocatable() ? offset : _image->sections[sectionIndex].address + offset;
+    auto it = std::upper_bound(syms.begin(), syms.end(), addr,
+        [](uint64_t address, const Symbol* sym) { return address < sym->address; });
+    // Walk back over zero-sized labels and symbols sharing the same start (aliases)
+    while (it != syms.begin()) {
+        const Symbol* sym = *--it;
+        if (addr < sym->address + sym->size) return sym;
+        if (sym->size != 0 && (it == syms.begin() || (*(it - 1))->address != sym->address)) break;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Find the nearest symbol with offset <= given offset within a section.
+ * @param sectionIndex Index of the section header.
+ * @param offset       Offset within the section.
+ * @return Pointer to nearest Symbol if found, nullptr otherwise.
+ */
+const Symbol* MiniELF::getNearestSymbolInSection(uint32_t sectionIndex, uint64_t offset) const {
+    SymbolSpan syms = getSymbolsInSection(sectionIndex);
+    uint64_t addr = isRelocatable() ? offset : _image->sections[sectionIndex].address + offset;
+    auto it = std::upper_bound(syms.begin(), syms.end(), addr,
+        [](uint64_t address, const Symbol* sym) { return address < sym->address; });
+    if (it == syms.begin()) return nullptr;
+    return *(it - 1);
+}
+
+/**
+ * @brief Build the size-ordered symbol indexes.
+ *
+ * Symbols are ordered by decreasing size (ties by address) both globally and
+ * grouped by type, so top-N and size-range queries are a binary search plus a
+ * contiguous slice.
+ */
+void MiniELF::Image::buildSizeIndex() const {
+    auto bySize = [](const Symbol* a, const Symbol* b) {
+        if (a->size != b->size) return a->size > b->size;
+        return a->address < b->address;
+    };
+    symbolsBySize.clear();
+    symbolsBySize.reserve(symbols.size());
+    for (const auto& sym : symbols) symbolsBySize.push_back(&sym);
+    std::sort(symbolsBySize.begin(), symbolsBySize.end(), bySize);
+
+    symbolsByTypeAndSize = symbolsBySize;
+    std::stable_sort(symbolsByTypeAndSize.begin(), symbolsByTypeAndSize.end(),
+        [](const Symbol* a, const Symbol* b) { return a->type < b->type; });
+}
+
+/**
+ * @brief Get the part of the type-grouped size index holding one symbol type.
+ * @param type Symbol type.
+ * @return Span of symbols of that type, largest first.
+ */
+SymbolSpan MiniELF::symbolsOfType(SymbolType type) const {
+    _image->ensureIndex(LookupIndex::Sizes);
+    const Symbol* const* first = _image->symbolsByTypeAndSize.data();
+    const Symbol* const* last = first + _image->symbolsByTypeAndSize.size();
+    first = std::partition_point(first, last, [type](const Symbol* sym) { return sym->type < type; });
+    last = std::partition_point(first, last, [type](const Symbol* sym) { return sym->type == type; });
+    return SymbolSpan(first, last);
+}
+
+/**
+ * @brief Get the largest symbols, largest first.
+ * @param count Maximum number of symbols to return.
+ * @return Span of at most count symbols ordered by decreasing size.
+ */
+SymbolSpan MiniELF::getLargestSymbols(size_t count) const {
+    _image->ensureIndex(LookupIndex::Sizes);
+    const Symbol* const* first = _image->symbolsBySize.data();
+    return SymbolSpan(first, first + std::min(count, _image->symbolsBySize.size()));
+}
+
+/**
+ * @brief Get the largest symbols of a given type, largest first.
+ * @param count Maximum number of symbols to return.
+ * @param type  Symbol type to select.
+ * @return Span of at most count symbols ordered by decreasing size.
+ */
+SymbolSpan MiniELF::getLargestSymbols(size_t count, SymbolType type) const {
+    SymbolSpan syms = symbolsOfType(type);
+    return SymbolSpan(syms.begin(), syms.begin() + std::min(count, syms.size()));
+}
+
+/**
+ * @brief Get all symbols whose size lies in [minSize, maxSize], largest first.
+ * @param minSize Minimum size in bytes (inclusive).
+ * @param maxSize Maximum size in bytes (inclusive).
+ * @return Span of symbols ordered by decreasing size.
+ */
+SymbolSpan MiniELF::getSymbolsBySize(uint64_t minSize, uint64_t maxSize) const {
+    _image->ensureIndex(LookupIndex::Sizes);
+    const Symbol* const* first = _image->symbolsBySize.data();
+    return sliceBySize(SymbolSpan(first, first + _image->symbolsBySize.size()), minSize, maxSize);
+}
+
+/**
+ * @brief Get all symbols of a given type whose size lies in [minSize, maxSize].
+ * @param minSize Minimum size in bytes (inclusive).
+ * @param maxSize Maximum size in bytes (inclusive).
+ * @param type    Symbol type to select.
+ * @return Span of symbols ordered by decreasing size.
+ */
+SymbolSpan MiniELF::getSymbolsBySize(uint64_t minSize, uint64_t maxSize, SymbolType type) const {
+    return sliceBySize(symbolsOfType(type), minSize, maxSize);
+}
+
 /**
  * @brief Get a section by its address.
  * @param addr Address of the section to find.
  * @return Pointer to Section if found, nullptr otherwise.
  */
 const Section* MiniELF::getSectionByAddress(uint64_t addr) const {
-    buildLookups();
+    if (isRelocatable()) return nullptr;
+    if (useFallbackLookups(LookupIndex::Addresses)) {
+        const Section* best = nullptr;
+        for (const auto& sec : _image->sections) {
+            if (sec.address <= addr && addr < sec.address + sec.size && (!best || sec.address < best->address))
+                best = &sec;
+        }
+        return best;
+    }
+    _image->ensureIndex(LookupIndex::Addresses);
 
     auto it = std::lower_bound(
-        _sectionsSortedByAddr.begin(), _sectionsSortedByAddr.end(), addr,
+        _image->sectionsSortedByAddr.begin(), _image->sectionsSortedByAddr.end(), addr,
         [](const Section* sec, uint64_t address) {
             return sec->address + sec->size <= address;
         });
 
-    if (it != _sectionsSortedByAddr.end()) {
+    if (it != _image->sectionsSortedByAddr.end()) {
         const Section* sec = *it;
         if (sec->address <= addr && addr < sec->address + sec->size)
             return sec;
     }
 
-    if (it != _sectionsSortedByAddr.begin()) {
+    if (it != _image->sectionsSortedByAddr.begin()) {
         --it;
         const Section* sec = *it;
         if (sec->address <= addr && addr < sec->address + sec->size)
@@ -152,15 +1103,32 @@ const Section* MiniELF::getSectionByAddress(uint64_t addr) const {
     return nullptr;
 }
 
+/**
+ * @brief Get the sections intersecting an address window, in address order.
+ * @param lo First address of the window.
+ * @param hi End of the window (exclusive).
+ * @return View over the section address index.
+ */
+AddressRange<Section> MiniELF::getSectionsInRange(uint64_t lo, uint64_t hi) const {
+    if (isRelocatable()) return {};
+    _image->ensureIndex(LookupIndex::Addresses);
+    return findRange(_image->sectionsSortedByAddr, _image->sectionEndTree, lo, hi);
+}
+
 /**
  * @brief Get a section by its name.
  * @param name Name of the section to search for.
  * @return Pointer to Section if found, nullptr otherwise.
  */
-const Section* MiniELF::getSectionByName(const std::string& name) const {
-    buildLookups();
-    auto it = _sectionByName.find(name);
-    return it != _sectionByName.end() ? it->second : nullptr;
+const Section* MiniELF::getSectionByName(std::string_view name) const {
+    if (useFallbackLookups(LookupIndex::Sections)) {
+        for (auto it = _image->sections.rbegin(); it != _image->sections.rend(); ++it)
+            if (it->name == name) return &*it;
+        return nullptr;
+    }
+    _image->ensureIndex(LookupIndex::Sections);
+    auto it = _image->sectionByName.find(name);
+    return it != _image->sectionByName.end() ? it->second : nullptr;
 }
 
 /**
@@ -171,75 +1139,82 @@ ElfMetadata MiniELF::getMetadata() const {
     ElfMetadata meta{};
     if (!isValid()) return meta;
 
-    meta.type = _elfHeader.e_type;
-    meta.machine = _elfHeader.e_machine;
-    meta.version = _elfHeader.e_version;
-    meta.entry = _elfHeader.e_entry;
-    meta.flags = _elfHeader.e_flags;
+    meta.type = _image->elfHeader.e_type;
+    meta.machine = _image->elfHeader.e_machine;
+    meta.version = _image->elfHeader.e_version;
+    meta.entry = _image->elfHeader.e_entry;
+    meta.flags = _image->elfHeader.e_flags;
 
     return meta;
 }
 
 /**
- * @brief Parse the ELF file and populate sections and symbols.
+ * @brief Parse the ELF image and populate sections and symbols.
+ * @param source Source of the image bytes.
  */
-void MiniELF::parse() {
-    _failureStage = ParseStage::Header;
-    std::ifstream file(_filepath, std::ios::binary);
-    if (!file) {
-        setError("MiniELF error: failed to open file: " + _filepath);
-        return;
-    }
+void MiniELF::parse(const ByteSource& source) {
+    _image->failureStage = ParseStage::Header;
+    _image->fileSize = source.size();
 
     Elf64_Ehdr ehdr{};
-    file.read(reinterpret_cast<char*>(&ehdr), sizeof(ehdr));
-    if (file.gcount() != sizeof(ehdr)) {
-        setError("MiniELF error: failed to read ELF header");
-        return;
-    }
+    if (!readHeader(source, ehdr)) return;
 
-    if (ehdr.e_ident[0] != 0x7f || ehdr.e_ident[1] != 'E' ||
-        ehdr.e_ident[2] != 'L'  || ehdr.e_ident[3] != 'F') {
-        setError("MiniELF error: not an ELF file");
+    if (ehdr.e_shoff == 0) {
+        setError("MiniELF error: no section headers");
         return;
     }
 
-    if (ehdr.e_ident[4] != 2 /* ELFCLASS64 */) {
-        setError("MiniELF error: ELF32 not supported yet");
+    _image->failureStage = ParseStage::SectionHeaders;
+    // Extended numbering: with 0xff00 or more sections e_shnum is 0 and the real
+    // count lives in section 0's sh_size (likewise e_shstrndx/sh_link, e_phnum/sh_info)
+    Elf64_Shdr shdr0{};
+    if (source.readAt(ehdr.e_shoff, &shdr0, sizeof(shdr0)) != sizeof(shdr0)) {
+        setError("MiniELF error: failed to read section header");
         return;
     }
+    uint64_t shnum = ehdr.e_shnum != 0 ? ehdr.e_shnum : shdr0.sh_size;
+    uint32_t shstrndx = ehdr.e_shstrndx != 0xffff /* SHN_XINDEX */ ? ehdr.e_shstrndx : shdr0.sh_link;
+    _image->programHeaderCount = ehdr.e_phnum != 0xffff /* PN_XNUM */ ? ehdr.e_phnum : shdr0.sh_info;
 
-    if (ehdr.e_shoff == 0 || ehdr.e_shnum == 0) {
+    if (shnum == 0) {
         setError("MiniELF error: no section headers");
         return;
     }
+    if (ehdr.e_shoff > _image->fileSize || shnum > (_image->fileSize - ehdr.e_shoff) / sizeof(Elf64_Shdr)) {
+        setError("MiniELF error: failed to read section header");
+        return;
+    }
 
-    _failureStage = ParseStage::SectionHeaders;
-    file.seekg(ehdr.e_shoff, std::ios::beg);
-    std::vector<Elf64_Shdr> shdrs(ehdr.e_shnum);
-    for (auto& sh : shdrs) {
-        file.read(reinterpret_cast<char*>(&sh), sizeof(sh));
-        if (file.gcount() != sizeof(sh)) {
-            setError("MiniELF error: failed to read section header");
-            return;
-        }
+    // Read all section headers with a single bulk read
+    std::vector<Elf64_Shdr> shdrs(shnum);
+    const size_t shdrBytes = static_cast<size_t>(shnum * sizeof(Elf64_Shdr));
+    if (source.readAt(ehdr.e_shoff, shdrs.data(), shdrBytes) != shdrBytes) {
+        setError("MiniELF error: failed to read section header");
+        return;
     }
 
-    const auto& shstrtab = shdrs[ehdr.e_shstrndx];
+    if (shstrndx >= shdrs.size()) {
+        setError("MiniELF error: invalid section string table index");
+        return;
+    }
+    const auto& shstrtab = shdrs[shstrndx];
+    if (shstrtab.sh_offset > _image->fileSize || shstrtab.sh_size > _image->fileSize - shstrtab.sh_offset) {
+        setError("MiniELF error: failed to read section string table");
+        return;
+    }
     std::vector<char> shstr(shstrtab.sh_size);
-    file.seekg(shstrtab.sh_offset, std::ios::beg);
-    file.read(shstr.data(), shstr.size());
-    if (file.gcount() != static_cast<std::streamsize>(shstr.size())) {
+    if (source.readAt(shstrtab.sh_offset, shstr.data(), shstr.size()) != shstr.size()) {
         setError("MiniELF error: failed to read section string table");
         return;
     }
 
-    _sectionHeaders = shdrs;
-    _sectionStringTableRaw = shstr;
-    _elfHeader = ehdr;
+    _image->sectionHeaders = std::move(shdrs);
+    _image->sectionStringTableRaw = shstr;
+    _image->elfHeader = ehdr;
 
     // Populate sections
-    for (const auto& sh : shdrs) {
+    _image->sections.reserve(_image->sectionHeaders.size());
+    for (const auto& sh : _image->sectionHeaders) {
         Section sec;
 
         if (!shstr.empty() && sh.sh_name < shstr.size()) {
@@ -257,87 +1232,345 @@ void MiniELF::parse() {
 
         sec.address = sh.sh_addr;
         sec.size = sh.sh_size;
-        _sections.push_back(sec);
+        sec.index = static_cast<uint32_t>(_image->sections.size());
+        _image->sections.push_back(sec);
+    }
+
+    _image->failureStage = ParseStage::Symbols;
+    parseSymbols(source, _image->sectionHeaders, shstrndx);
+    parseBuildId(source, _image->sectionHeaders);
+
+    if (ehdr.e_phoff != 0 && _image->programHeaderCount > 0) {
+        _image->failureStage = ParseStage::ProgramHeaders;
+        // The count may come from shdr0.sh_info (PN_XNUM); never allocate past the image
+        if (ehdr.e_phoff > _image->fileSize ||
+            _image->programHeaderCount > (_image->fileSize - ehdr.e_phoff) / sizeof(Elf64_Phdr)) {
+            setError("MiniELF error: failed to read program header");
+            return;
+        }
+        _image->programHeaders.resize(_image->programHeaderCount);
+        const size_t phdrBytes = _image->programHeaders.size() * sizeof(Elf64_Phdr);
+        if (source.readAt(ehdr.e_phoff, _image->programHeaders.data(), phdrBytes) != phdrBytes) {
+            setError("MiniELF error: failed to read program header");
+            return;
+        }
     }
 
-    _failureStage = ParseStage::Symbols;
-    parseSymbols(file, shstr, shdrs, ehdr);
+    _image->valid = true;
+}
+
+
+/**
+ * @brief Read and validate the ELF header.
+ * @param source Source of the image bytes.
+ * @param ehdr   Receives the header.
+ * @return true if the header describes a supported ELF image, false otherwise.
+ */
+bool MiniELF::readHeader(const ByteSource& source, Elf64_Ehdr& ehdr) {
+    if (source.readAt(0, &ehdr, sizeof(ehdr)) != sizeof(ehdr)) {
+        setError("MiniELF error: failed to read ELF header");
+        return false;
+    }
+
+    if (ehdr.e_ident[0] != 0x7f || ehdr.e_ident[1] != 'E' ||
+        ehdr.e_ident[2] != 'L'  || ehdr.e_ident[3] != 'F') {
+        setError("MiniELF error: not an ELF file");
+        return false;
+    }
+
+    if (ehdr.e_ident[4] != 2 /* ELFCLASS64 */) {
+        setError("MiniELF error: ELF32 not supported yet");
+        return false;
+    }
+    return true;
+}
 
-    if (ehdr.e_phoff != 0 && ehdr.e_phnum > 0) {
-        _failureStage = ParseStage::ProgramHeaders;
-        file.seekg(ehdr.e_phoff, std::ios::beg);
-        _programHeaders.resize(ehdr.e_phnum);
-        for (auto& ph : _programHeaders) {
-            file.read(reinterpret_cast<char*>(&ph), sizeof(ph));
-            if (file.gcount() != sizeof(ph)) {
-                setError("MiniELF error: failed to read program header");
-                return;
+/**
+ * @brief Parse an image as mapped by the loader.
+ *
+ * Section headers are usually not part of a loaded image, so sections stay
+ * empty and the dynamic symbols are reconstructed from PT_DYNAMIC: DT_SYMTAB,
+ * DT_STRTAB/DT_STRSZ and the symbol count from DT_HASH or DT_GNU_HASH.
+ * @param source      Source of the image bytes, offset 0 being the load base.
+ * @param loadAddress Runtime address of the first byte of the source.
+ */
+void MiniELF::parseLoaded(const ByteSource& source, uint64_t loadAddress) {
+    _image->failureStage = ParseStage::Header;
+    _image->fileSize = source.size();
+
+    Elf64_Ehdr ehdr{};
+    if (!readHeader(source, ehdr)) return;
+    _image->elfHeader = ehdr;
+
+    _image->failureStage = ParseStage::ProgramHeaders;
+    _image->programHeaderCount = ehdr.e_phnum;
+    if (ehdr.e_phoff == 0 || ehdr.e_phnum == 0 || ehdr.e_phnum == 0xffff /* PN_XNUM */) {
+        setError("MiniELF error: no program headers");
+        return;
+    }
+    _image->programHeaders.resize(ehdr.e_phnum);
+    const size_t phdrBytes = _image->programHeaders.size() * sizeof(Elf64_Phdr);
+    if (source.readAt(ehdr.e_phoff, _image->programHeaders.data(), phdrBytes) != phdrBytes) {
+        _image->programHeaders.clear();
+        setError("MiniELF error: failed to read program header");
+        return;
+    }
+
+    // The load base is the address the first PT_LOAD maps file offset 0 to
+    const Elf64_Phdr* dynamic = nullptr;
+    bool foundLoad = false;
+    uint64_t loadBase = 0;
+    for (const auto& ph : _image->programHeaders) {
+        if (ph.p_type == 1 /* PT_LOAD */ && !foundLoad) {
+            loadBase = ph.p_vaddr - ph.p_offset;
+            foundLoad = true;
+        } else if (ph.p_type == 2 /* PT_DYNAMIC */) {
+            dynamic = &ph;
+        }
+    }
+    if (!foundLoad) {
+        setError("MiniELF error: no loadable segment");
+        return;
+    }
+
+    // Translate a virtual address to a source offset. The loader may have
+    // relocated the pointers in .dynamic in place (glibc does, unless the
+    // section is read-only), so runtime addresses are accepted as well.
+    auto toOffset = [&](uint64_t addr, uint64_t& offset) {
+        if (loadAddress != 0 && addr >= loadAddress && addr - loadAddress < _image->fileSize) {
+            offset = addr - loadAddress;
+            return true;
+        }
+        if (addr >= loadBase && addr - loadBase < _image->fileSize) {
+            offset = addr - loadBase;
+            return true;
+        }
+        return false;
+    };
+
+    // Build ID from the PT_NOTE segments
+    std::vector<char> notes;
+    for (const auto& ph : _image->programHeaders) {
+        uint64_t offset;
+        if (ph.p_type != 4 /* PT_NOTE */ || ph.p_filesz > 0x10000 || !toOffset(ph.p_vaddr, offset)) continue;
+        notes.resize(static_cast<size_t>(ph.p_filesz));
+        if (source.readAt(offset, notes.data(), notes.size()) != notes.size()) continue;
+        if (findBuildId(notes.data(), notes.size(), _image->buildId)) break;
+    }
+
+    _image->failureStage = ParseStage::Symbols;
+    uint64_t dynOffset;
+    if (!dynamic || !toOffset(dynamic->p_vaddr, dynOffset)) {
+        // Fully static images have no dynamic symbols
+        _image->valid = true;
+        return;
+    }
+    std::vector<Elf64_Dyn> dyn(static_cast<size_t>(std::min<uint64_t>(dynamic->p_memsz, _image->fileSize - dynOffset) / sizeof(Elf64_Dyn)));
+    dyn.resize(source.readAt(dynOffset, dyn.data(), dyn.size() * sizeof(Elf64_Dyn)) / sizeof(Elf64_Dyn));
+
+    uint64_t symtabAddr = 0, strtabAddr = 0, strsz = 0, syment = sizeof(Elf64_Sym);
+    uint64_t hashAddr = 0, gnuHashAddr = 0;
+    for (const auto& d : dyn) {
+        if (d.d_tag == 0 /* DT_NULL */) break;
+        switch (d.d_tag) {
+            case 4 /* DT_HASH */: hashAddr = d.d_val; break;
+            case 5 /* DT_STRTAB */: strtabAddr = d.d_val; break;
+            case 6 /* DT_SYMTAB */: symtabAddr = d.d_val; break;
+            case 10 /* DT_STRSZ */: strsz = d.d_val; break;
+            case 11 /* DT_SYMENT */: syment = d.d_val; break;
+            case 0x6ffffef5 /* DT_GNU_HASH */: gnuHashAddr = d.d_val; break;
+            default: break;
+        }
+    }
+
+    uint64_t symtabOffset, strtabOffset;
+    if (!toOffset(symtabAddr, symtabOffset) || !toOffset(strtabAddr, strtabOffset) ||
+        syment < sizeof(Elf64_Sym)) {
+        setError("MiniELF error: no dynamic symbol table");
+        return;
+    }
+
+    // The symbol count is not recorded in .dynamic; take it from a hash table
+    uint64_t count = 0;
+    uint64_t hashOffset;
+    if (hashAddr && toOffset(hashAddr, hashOffset)) {
+        // DT_HASH: nbucket, nchain, where nchain equals the number of symbols
+        uint32_t header[2];
+        if (source.readAt(hashOffset, header, sizeof(header)) == sizeof(header)) count = header[1];
+    } else if (gnuHashAddr && toOffset(gnuHashAddr, hashOffset)) {
+        // DT_GNU_HASH: nbuckets, symoffset, bloom_size, bloom_shift, bloom[], buckets[], chains[].
+        // Hashed symbols end with the chain of the highest bucket entry, whose
+        // last element has the low bit set.
+        uint32_t header[4];
+        if (source.readAt(hashOffset, header, sizeof(header)) == sizeof(header)) {
+            const uint64_t bucketsOffset = hashOffset + sizeof(header) + uint64_t(header[2]) * 8;
+            std::vector<uint32_t> buckets(std::min<uint64_t>(header[0], (_image->fileSize - std::min(_image->fileSize, bucketsOffset)) / 4));
+            if (source.readAt(bucketsOffset, buckets.data(), buckets.size() * 4) == buckets.size() * 4) {
+                uint32_t last = 0;
+                for (uint32_t b : buckets) last = std::max(last, b);
+                count = header[1];
+                if (last >= header[1]) {
+                    const uint64_t chainsOffset = bucketsOffset + buckets.size() * 4;
+                    uint32_t chain = 0;
+                    uint64_t pos = chainsOffset + uint64_t(last - header[1]) * 4;
+                    while (source.readAt(pos, &chain, 4) == 4) {
+                        ++last;
+                        if (chain & 1) break;
+                        pos += 4;
+                    }
+                    count = last;
+                }
             }
         }
     }
+    if (count == 0) {
+        setError("MiniELF error: no symbol hash table");
+        return;
+    }
+
+    // Clamp the tables to the image so a corrupt .dynamic cannot trigger huge allocations
+    count = std::min<uint64_t>(count, (_image->fileSize - symtabOffset) / syment);
+    strsz = std::min<uint64_t>(strsz, _image->fileSize - strtabOffset);
+    const size_t entsize = static_cast<size_t>(syment);
+    const size_t numSymbols = static_cast<size_t>(count);
+    std::vector<char> strtab(static_cast<size_t>(strsz));
+
+    const char* table = source.view(symtabOffset, numSymbols * entsize);
+    std::vector<char> tableCopy;
+    if (table) {
+        source.readAt(strtabOffset, strtab.data(), strtab.size());
+    } else {
+        tableCopy.resize(numSymbols * entsize);
+        ReadRequest requests[2] = {
+            {symtabOffset, tableCopy.data(), tableCopy.size()},
+            {strtabOffset, strtab.data(), strtab.size()},
+        };
+        source.readBatch(requests, 2).get();
+        table = tableCopy.data();
+    }
+    addSymbols(table, numSymbols, entsize, std::move(strtab), {});
 
-    _valid = true;
+    _image->valid = true;
 }
 
+/**
+ * @brief Read the GNU build ID from the SHT_NOTE sections, if any.
+ *
+ * A missing or malformed note is not an error; the build ID stays empty.
+ * @param source Source of the image bytes.
+ * @param shdrs  Section headers.
+ */
+void MiniELF::parseBuildId(const ByteSource& source, const std::vector<Elf64_Shdr>& shdrs) {
+    std::vector<char> copy;
+    for (const auto& sh : shdrs) {
+        if (sh.sh_type != 7 /* SHT_NOTE */ || sh.sh_size > 0x10000 ||
+            sh.sh_offset > _image->fileSize || sh.sh_size > _image->fileSize - sh.sh_offset) continue;
+        const size_t size = static_cast<size_t>(sh.sh_size);
+        const char* notes = source.view(sh.sh_offset, size);
+        if (!notes) {
+            copy.resize(size);
+            if (source.readAt(sh.sh_offset, copy.data(), size) != size) continue;
+            notes = copy.data();
+        }
+
+        if (findBuildId(notes, size, _image->buildId)) return;
+    }
+}
 
 /**
- * @brief Parse symbols from the ELF file.
- * @param file      Input file stream (already open).
- * @param shstrtab  Section header string table.
+ * @brief Parse symbols from the ELF image.
+ *
+ * Sources with views are read in place; otherwise the symbol table, its
+ * string table and the extended section index table are fetched with one
+ * batch of reads.
+ * @param source    Source of the image bytes.
  * @param shdrs     Section headers.
- * @param ehdr      ELF header.
+ * @param shstrndx  Index of the section header string table.
  */
-void MiniELF::parseSymbols(std::ifstream& file, const std::vector<char>& shstrtab,
-                           const std::vector<Elf64_Shdr>& shdrs, const Elf64_Ehdr& ehdr) {
+void MiniELF::parseSymbols(const ByteSource& source, const std::vector<Elf64_Shdr>& shdrs,
+                           uint32_t shstrndx) {
     Elf64_Shdr symtab_hdr{};
     Elf64_Shdr strtab_hdr{};
+    size_t symtab_index = 0;
     bool found_symtab = false;
     bool found_strtab = false;
 
-    // 1. Try to find .symtab + .strtab
-    for (size_t i = 0; i < shdrs.size(); ++i) {
-        const auto& sh = shdrs[i];
-        if (sh.sh_type == 2 /* SHT_SYMTAB */) {
-            symtab_hdr = sh;
-            found_symtab = true;
-        } else if (sh.sh_type == 3 /* SHT_STRTAB */ &&
-            i != ehdr.e_shstrndx) {
-            strtab_hdr = sh;
-            found_strtab = true;
-        }
-    }
-
-    // 2. If not found, try .dynsym + .dynstr
-    if (!found_symtab) {
+    // 1. Try to find .symtab, 2. if not found, try .dynsym
+    for (uint32_t type : {2u /* SHT_SYMTAB */, 11u /* SHT_DYNSYM */}) {
         for (size_t i = 0; i < shdrs.size(); ++i) {
-            const auto& sh = shdrs[i];
-            if (sh.sh_type == 11 /* SHT_DYNSYM */) {
-                symtab_hdr = sh;
+            if (shdrs[i].sh_type == type) {
+                symtab_hdr = shdrs[i];
+                symtab_index = i;
                 found_symtab = true;
-            } else if (sh.sh_type == 3 /* SHT_STRTAB */ &&
-                       i != ehdr.e_shstrndx &&
-                       (symtab_hdr.sh_link == i)) {
-                strtab_hdr = sh;
-                found_strtab = true;
+                break;
             }
         }
+        if (found_symtab) break;
     }
 
-    if (!found_symtab || !found_strtab) return;
+    // The associated string table is the one referenced by sh_link
+    if (found_symtab && symtab_hdr.sh_link < shdrs.size() &&
+        symtab_hdr.sh_link != shstrndx &&
+        shdrs[symtab_hdr.sh_link].sh_type == 3 /* SHT_STRTAB */) {
+        strtab_hdr = shdrs[symtab_hdr.sh_link];
+        found_strtab = true;
+    }
 
-    // Read symbols
-    size_t num_symbols = symtab_hdr.sh_size / symtab_hdr.sh_entsize;
-    file.seekg(symtab_hdr.sh_offset, std::ios::beg);
-    std::vector<Elf64_Sym> symbols(num_symbols);
-    file.read(reinterpret_cast<char*>(symbols.data()), symtab_hdr.sh_size);
+    if (!found_symtab || !found_strtab || symtab_hdr.sh_entsize < sizeof(Elf64_Sym)) return;
 
-    // Read string table for symbols
-    std::vector<char> strtab(strtab_hdr.sh_size);
-    file.seekg(strtab_hdr.sh_offset, std::ios::beg);
-    file.read(strtab.data(), strtab.size());
+    // Clamp the tables to the image so a corrupt header cannot trigger huge allocations
+    auto clamp = [this](const Elf64_Shdr& sh) {
+        return sh.sh_offset > _image->fileSize ? 0 : std::min<uint64_t>(sh.sh_size, _image->fileSize - sh.sh_offset);
+    };
+    const size_t entsize = static_cast<size_t>(symtab_hdr.sh_entsize);
+    const size_t num_symbols = static_cast<size_t>(clamp(symtab_hdr) / entsize);
+    std::vector<char> strtab(static_cast<size_t>(clamp(strtab_hdr)));
 
+    // Section indices that do not fit st_shndx live in SHT_SYMTAB_SHNDX
+    const Elf64_Shdr* shndx_hdr = nullptr;
+    for (const auto& sh : shdrs) {
+        if (sh.sh_type == 18 /* SHT_SYMTAB_SHNDX */ && sh.sh_link == symtab_index) {
+            shndx_hdr = &sh;
+            break;
+        }
+    }
+    std::vector<uint32_t> shndx(shndx_hdr ? std::min<uint64_t>(clamp(*shndx_hdr) / sizeof(uint32_t), num_symbols) : 0);
+
+    const char* table = source.view(symtab_hdr.sh_offset, num_symbols * entsize);
+    std::vector<char> tableCopy;
+    if (table) {
+        source.readAt(strtab_hdr.sh_offset, strtab.data(), strtab.size());
+        if (shndx_hdr) source.readAt(shndx_hdr->sh_offset, shndx.data(), shndx.size() * sizeof(uint32_t));
+    } else {
+        tableCopy.resize(num_symbols * entsize);
+        ReadRequest requests[3] = {
+            {symtab_hdr.sh_offset, tableCopy.data(), tableCopy.size()},
+            {strtab_hdr.sh_offset, strtab.data(), strtab.size()},
+            {shndx_hdr ? shndx_hdr->sh_offset : 0, shndx.data(), shndx.size() * sizeof(uint32_t)},
+        };
+        source.readBatch(requests, shndx_hdr ? 3 : 2).get();
+        table = tableCopy.data();
+    }
+
+    addSymbols(table, num_symbols, entsize, std::move(strtab), shndx);
+}
+
+/**
+ * @brief Decode a symbol table and append its symbols.
+ * @param table   First symbol table entry.
+ * @param count   Number of entries.
+ * @param entsize Size of one entry in bytes.
+ * @param strtab  Symbol string table; becomes the raw symbol string table.
+ * @param shndx   Extended section indices (SHT_SYMTAB_SHNDX), may be empty.
+ */
+void MiniELF::addSymbols(const char* table, size_t count, size_t entsize, std::vector<char> strtab,
+                         const std::vector<uint32_t>& shndx) {
     // Populate symbols
-    for (const auto& sym : symbols) {
+    _image->symbols.reserve(count);
+    _image->symbolNameOffsets.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        Elf64_Sym sym;
+        memcpy(&sym, table + i * entsize, sizeof(sym));
         Symbol s;
 
         if (!strtab.empty() && sym.st_name < strtab.size()) {
@@ -356,8 +1589,17 @@ void MiniELF::parseSymbols(std::ifstream& file, const std::vector<char>& shstrta
         s.address = sym.st_value;
         s.size = sym.st_size;
         s.type = static_cast<SymbolType>(sym.st_info & 0x0F);
-        _symbols.push_back(s);
+        if (sym.st_shndx == 0xffff /* SHN_XINDEX */) {
+            s.sectionIndex = i < shndx.size() ? shndx[i] : 0;
+        } else if (sym.st_shndx >= 0xff00 /* SHN_LORESERVE */) {
+            s.sectionIndex = 0xffff0000u | sym.st_shndx;
+        } else {
+            s.sectionIndex = sym.st_shndx;
+        }
+        _image->symbols.push_back(s);
+        _image->symbolNameOffsets.push_back(sym.st_name);
     }
+    _image->symbolStringTableRaw = std::move(strtab);
 }
 
 
@@ -366,7 +1608,7 @@ void MiniELF::parseSymbols(std::ifstream& file, const std::vector<char>& shstrta
  * @return Reference to the internal ELF header structure.
  */
 const Elf64_Ehdr& MiniELF::getRawHeader() const {
-    return _elfHeader;
+    return _image->elfHeader;
 }
 
 /**
@@ -374,7 +1616,15 @@ const Elf64_Ehdr& MiniELF::getRawHeader() const {
  * @return Reference to the vector of section header structures.
  */
 const std::vector<Elf64_Shdr>& MiniELF::getSectionHeaders() const {
-    return _sectionHeaders;
+    return _image->sectionHeaders;
+}
+
+/**
+ * @brief Get the path (or name) the ELF file was opened with.
+ * @return Reference to the path string.
+ */
+const std::string& MiniELF::getFilePath() const {
+    return _image->filepath;
 }
 
 /**
@@ -382,9 +1632,117 @@ const std::vector<Elf64_Shdr>& MiniELF::getSectionHeaders() const {
  * @return File size in bytes, or 0 if file is not accessible.
  */
 uint64_t MiniELF::getFileSize() const {
-    std::ifstream file(_filepath, std::ios::binary | std::ios::ate);
-    if (!file) return 0;
-    return static_cast<uint64_t>(file.tellg());
+    return _image->fileSize;
+}
+
+/**
+ * @brief Merge external symbols into the address index.
+ * @param symbols  Symbols to add.
+ * @param priority Priority of the batch.
+ */
+void MiniELF::addOverlaySymbols(std::vector<Symbol> symbols, int priority) {
+    if (symbols.empty()) return;
+    Image& image = mutableImage();
+    if (image.indexWarmer.joinable()) image.indexWarmer.join();
+
+    std::vector<const Symbol*> batch;
+    batch.reserve(symbols.size());
+    for (auto& sym : symbols) {
+        if (sym.sectionIndex == 0) sym.sectionIndex = 0xfffffff1; // SHN_ABS, not undefined
+        image.overlaySymbols.push_back(std::move(sym));
+        batch.push_back(&image.overlaySymbols.back());
+        image.overlayPriorities.emplace(batch.back(), priority);
+    }
+    // An address index not built yet picks the overlays up when it is
+    if (!image.areIndexesReady(LookupIndex::Addresses)) return;
+    std::stable_sort(batch.begin(), batch.end(),
+        [](const Symbol* a, const Symbol* b) { return a->address < b->address; });
+
+    // Order by (address, priority); the stable merge puts the new batch after
+    // existing symbols of the same key, so it wins lookups on ties
+    const size_t existing = image.symbolsSortedByAddr.size();
+    image.symbolsSortedByAddr.insert(image.symbolsSortedByAddr.end(), batch.begin(), batch.end());
+    std::inplace_merge(image.symbolsSortedByAddr.begin(), image.symbolsSortedByAddr.begin() + existing,
+        image.symbolsSortedByAddr.end(), [&image](const Symbol* a, const Symbol* b) {
+            if (a->address != b->address) return a->address < b->address;
+            return image.overlayPriority(a) < image.overlayPriority(b);
+        });
+    buildEndTree(image.symbolsSortedByAddr, image.symbolEndTree);
+}
+
+/**
+ * @brief Merge a perf map file into the address index.
+ * @param path     Path of the map file.
+ * @param priority Priority of the symbols.
+ * @return true if the file could be read, false otherwise.
+ */
+bool MiniELF::loadPerfMap(const std::string& path, int priority) {
+    return loadOverlayFile(path, priority, false);
+}
+
+/**
+ * @brief Merge a plain text symbol list into the address index.
+ * @param path     Path of the symbol list.
+ * @param priority Priority of the symbols.
+ * @return true if the file could be read, false otherwise.
+ */
+bool MiniELF::loadSymbolList(const std::string& path, int priority) {
+    return loadOverlayFile(path, priority, true);
+}
+
+/**
+ * @brief Ingest the unread complete lines of an overlay text file.
+ * @param path     Path of the file.
+ * @param priority Priority of the symbols.
+ * @param withType Whether lines carry a type column.
+ * @return true if the file could be read, false otherwise.
+ */
+bool MiniELF::loadOverlayFile(const std::string& path, int priority, bool withType) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        setError("MiniELF error: failed to open overlay file: " + path);
+        return false;
+    }
+    file.seekg(0, std::ios::end);
+    const uint64_t size = static_cast<uint64_t>(file.tellg());
+    uint64_t& offset = mutableImage().overlayFileOffsets[path];
+    if (offset > size) offset = 0; // truncated and rewritten
+    std::string text(size - offset, '\0');
+    file.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+    file.read(&text[0], static_cast<std::streamsize>(text.size()));
+    if (file.gcount() != static_cast<std::streamsize>(text.size())) {
+        setError("MiniELF error: failed to read overlay file: " + path);
+        return false;
+    }
+
+    // Only complete lines are consumed; a partially written last line is
+    // picked up by the next call
+    std::vector<Symbol> symbols;
+    size_t pos = 0;
+    for (size_t nl; (nl = text.find('\n', pos)) != std::string::npos; pos = nl + 1) {
+        Symbol sym;
+        if (parseOverlayLine(text.data() + pos, text.data() + nl, withType, sym))
+            symbols.push_back(std::move(sym));
+    }
+    offset += pos;
+    addOverlaySymbols(std::move(symbols), priority);
+    return true;
+}
+
+/**
+ * @brief Get the number of overlay symbols merged so far.
+ * @return Number of overlay symbols.
+ */
+size_t MiniELF::getOverlaySymbolCount() const {
+    return _image->overlaySymbols.size();
+}
+
+/**
+ * @brief Get the GNU build ID.
+ * @return Reference to the build ID bytes (empty if the file has none).
+ */
+const std::vector<uint8_t>& MiniELF::getBuildId() const {
+    return _image->buildId;
 }
 
 /**
@@ -392,7 +1750,7 @@ uint64_t MiniELF::getFileSize() const {
  * @return Reference to the vector of program header structures.
  */
 const std::vector<Elf64_Phdr>& MiniELF::getProgramHeaders() const {
-    return _programHeaders;
+    return _image->programHeaders;
 }
 
 /**
@@ -400,7 +1758,23 @@ const std::vector<Elf64_Phdr>& MiniELF::getProgramHeaders() const {
  * @return Reference to the vector containing the raw section string table.
  */
 const std::vector<char>& MiniELF::getSectionStringTableRaw() const {
-    return _sectionStringTableRaw;
+    return _image->sectionStringTableRaw;
+}
+
+/**
+ * @brief Get the raw string table the symbol names were read from.
+ * @return Reference to the vector containing the raw symbol string table.
+ */
+const std::vector<char>& MiniELF::getSymbolStringTableRaw() const {
+    return _image->symbolStringTableRaw;
+}
+
+/**
+ * @brief Get the raw name offsets (st_name) of all symbols.
+ * @return Reference to the vector of offsets, indexed like getSymbols().
+ */
+const std::vector<uint32_t>& MiniELF::getSymbolNameOffsets() const {
+    return _image->symbolNameOffsets;
 }
 
 /**
@@ -408,7 +1782,7 @@ const std::vector<char>& MiniELF::getSectionStringTableRaw() const {
  * @return ParseStage enum value indicating the failure stage.
  */
 minielf::MiniELF::ParseStage MiniELF::getFailureStage() const {
-    return _failureStage;
+    return _image->failureStage;
 }
 
 /**
@@ -418,13 +1792,13 @@ minielf::MiniELF::ParseStage MiniELF::getFailureStage() const {
 std::string MiniELF::getValidationLog() const {
     std::string log;
 
-    if (_lastError.empty() && _valid) {
+    if (_lastError.empty() && _image->valid) {
         log += "ELF file parsed successfully.\n";
     } else {
         log += "ELF file parsing failed.\n";
         log += "Error: " + _lastError + "\n";
         log += "Failure stage: ";
-        switch (_failureStage) {
+        switch (_image->failureStage) {
             case ParseStage::Header: log += "Header"; break;
             case ParseStage::SectionHeaders: log += "SectionHeaders"; break;
             case ParseStage::Symbols: log += "Symbols"; break;
@@ -434,11 +1808,11 @@ std::string MiniELF::getValidationLog() const {
         log += "\n";
     }
 
-    log += "ELF file: " + _filepath + "\n";
-    log += "Valid: " + std::string(_valid ? "yes" : "no") + "\n";
-    log += "Sections parsed: " + std::to_string(_sections.size()) + "\n";
-    log += "Symbols parsed: " + std::to_string(_symbols.size()) + "\n";
-    log += "Program headers parsed: " + std::to_string(_programHeaders.size()) + "\n";
+    log += "ELF file: " + _image->filepath + "\n";
+    log += "Valid: " + std::string(_image->valid ? "yes" : "no") + "\n";
+    log += "Sections parsed: " + std::to_string(_image->sections.size()) + "\n";
+    log += "Symbols parsed: " + std::to_string(_image->symbols.size()) + "\n";
+    log += "Program headers parsed: " + std::to_string(_image->programHeaders.size()) + "\n";
 
     return log;
 }
@@ -0,0 +1,229 @@
+#include "minielf/NameScanner.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cctype>
+#include <string.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace minielf {
+
+namespace {
+
+/**
+ * @brief Find the first occurrence of needle in [hay, end).
+ *
+ * The SSE2 path compares the first and last needle bytes against 16 candidate
+ * positions at once and only runs memcmp where both match.
+ * @return Pointer to the match, or nullptr if there is none.
+ */
+const char* findBytes(const char* hay, const char* end, const char* needle, size_t m) {
+    if (static_cast<size_t>(end - hay) < m) return nullptr;
+    const char* last = end - m; // last valid start position
+    const char* p = hay;
+#if defined(__SSE2__)
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i tail = _mm_set1_epi8(needle[m - 1]);
+    for (; p + 15 <= last; p += 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + m - 1));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, tail))));
+        while (mask) {
+            const char* candidate = p + __builtin_ctz(mask);
+            if (memcmp(candidate, needle, m) == 0) return candidate;
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; p <= last; ++p) {
+        p = static_cast<const char*>(memchr(p, needle[0], static_cast<size_t>(last - p) + 1));
+        if (!p) return nullptr;
+        if (memcmp(p, needle, m) == 0) return p;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+/**
+ * @brief Prepare a scanner for the symbols of an ELF file.
+ * @param elf     Parsed ELF file.
+ * @param threads Number of worker threads (0 = hardware concurrency).
+ */
+NameScanner::NameScanner(const MiniELF& elf, unsigned threads)
+    : _strtab(elf.getSymbolStringTableRaw()), _nameOffsets(elf.getSymbolNameOffsets()),
+      _threads(detail::resolveThreadCount(threads, elf.getSymbolStringTableRaw().size())) {
+    _sortedOffsets.reserve(_nameOffsets.size());
+    for (uint32_t i = 0; i < _nameOffsets.size(); ++i) {
+        if (_nameOffsets[i] != 0 && _nameOffsets[i] < _strtab.size())
+            _sortedOffsets.push_back((static_cast<uint64_t>(_nameOffsets[i]) << 32) | i);
+    }
+    std::sort(_sortedOffsets.begin(), _sortedOffsets.end());
+
+    // Split the table into one chunk per thread, moving each cut past the
+    // next NUL so no string straddles two chunks
+    _chunks.push_back(0);
+    for (unsigned t = 1; t < _threads; ++t) {
+        size_t cut = std::max(_strtab.size() * t / _threads, _chunks.back());
+        const void* nul = cut < _strtab.size() ? memchr(_strtab.data() + cut, '\0', _strtab.size() - cut) : nullptr;
+        cut = nul ? static_cast<size_t>(static_cast<const char*>(nul) - _strtab.data()) + 1 : _strtab.size();
+        _chunks.push_back(cut);
+    }
+    _chunks.push_back(_strtab.size());
+}
+
+/**
+ * @brief Find symbols whose name contains a substring.
+ * @param needle Substring to search for.
+ * @return Indices into MiniELF::getSymbols(), in increasing order.
+ */
+std::vector<uint32_t> NameScanner::findContaining(std::string_view needle) const {
+    if (needle.empty() || needle.find('\0') != std::string_view::npos) return {};
+
+    const char* base = _strtab.data();
+    std::vector<std::vector<uint32_t>> found(_chunks.size() - 1);
+    detail::parallelForEach(found.size(), _threads, [&](size_t c) {
+        const char* chunkBegin = base + _chunks[c];
+        const char* chunkEnd = base + _chunks[c + 1];
+        const char* p = chunkBegin;
+        while (const char* hit = findBytes(p, chunkEnd, needle.data(), needle.size())) {
+            const char* strBegin = hit;
+            while (strBegin > chunkBegin && strBegin[-1] != '\0') --strBegin;
+            const char* strEnd = static_cast<const char*>(memchr(hit, '\0', chunkEnd - hit));
+            if (!strEnd) strEnd = chunkEnd;
+
+            // Every symbol starting at or before the last hit in this string
+            // contains the needle (names may be tail-merged into longer strings)
+            const char* lastHit = hit;
+            while (const char* next = findBytes(lastHit + 1, strEnd, needle.data(), needle.size()))
+                lastHit = next;
+            uint64_t lo = static_cast<uint64_t>(strBegin - base) << 32;
+            uint64_t hi = (static_cast<uint64_t>(lastHit - base) << 32) | 0xffffffffu;
+            auto first = std::lower_bound(_sortedOffsets.begin(), _sortedOffsets.end(), lo);
+            auto last = std::upper_bound(first, _sortedOffsets.end(), hi);
+            for (auto it = first; it != last; ++it) found[c].push_back(static_cast<uint32_t>(*it));
+
+            if (strEnd == chunkEnd) break;
+            p = strEnd + 1;
+        }
+    });
+
+    std::vector<uint32_t> result;
+    for (const auto& part : found) result.insert(result.end(), part.begin(), part.end());
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+/**
+ * @brief Find symbols whose name matches a regular expression.
+ * @param pattern Regular expression.
+ * @param flags   Regex syntax options.
+ * @return Indices into MiniELF::getSymbols(), in increasing order.
+ */
+std::vector<uint32_t> NameScanner::findMatching(const std::string& pattern,
+                                                std::regex_constants::syntax_option_type flags) const {
+    const std::regex re(pattern, flags);
+
+    std::vector<uint32_t> candidates;
+    std::string literal;
+    if ((flags & std::regex_constants::icase) == 0 &&
+        (flags & (std::regex_constants::basic | std::regex_constants::extended |
+                  std::regex_constants::awk | std::regex_constants::grep |
+                  std::regex_constants::egrep)) == 0) {
+        literal = requiredLiteral(pattern);
+    }
+    if (!literal.empty()) {
+        candidates = findContaining(literal);
+    } else {
+        candidates.resize(_nameOffsets.size());
+        for (uint32_t i = 0; i < candidates.size(); ++i) candidates[i] = i;
+    }
+
+    // Run the regex over the candidates in place, one slice per thread
+    const char* base = _strtab.data();
+    const size_t slices = detail::resolveThreadCount(_threads, candidates.size());
+    std::vector<std::vector<uint32_t>> matched(slices);
+    detail::parallelForEach(slices, _threads, [&](size_t t) {
+        size_t begin = candidates.size() * t / slices;
+        size_t end = candidates.size() * (t + 1) / slices;
+        for (size_t i = begin; i < end; ++i) {
+            uint32_t off = _nameOffsets[candidates[i]];
+            if (off >= _strtab.size()) continue;
+            const char* name = base + off;
+            const char* nameEnd = static_cast<const char*>(memchr(name, '\0', _strtab.size() - off));
+            if (!nameEnd) nameEnd = base + _strtab.size();
+            if (std::regex_search(name, nameEnd, re)) matched[t].push_back(candidates[i]);
+        }
+    });
+
+    std::vector<uint32_t> result;
+    for (const auto& part : matched) result.insert(result.end(), part.begin(), part.end());
+    return result;
+}
+
+/**
+ * @brief Extract the longest literal every match of an ECMAScript pattern must contain.
+ *
+ * Conservative: patterns with alternation yield no literal, only top-level
+ * (ungrouped) runs are considered, and a character followed by `?`, `*` or
+ * `{` is treated as optional.
+ * @param pattern Regular expression.
+ * @return Required literal, or an empty string.
+ */
+std::string NameScanner::requiredLiteral(const std::string& pattern) {
+    if (pattern.find('|') != std::string::npos) return {};
+
+    std::string best, run;
+    int depth = 0;
+    auto flush = [&]() {
+        if (depth == 0 && run.size() > best.size()) best = run;
+        run.clear();
+    };
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        char c = pattern[i];
+        switch (c) {
+        case '\\':
+            if (i + 1 < pattern.size() && !isalnum(static_cast<unsigned char>(pattern[i + 1]))) {
+                run.push_back(pattern[++i]);
+            } else {
+                flush(); // class escape (\d, \w, \b, ...), code point or back-reference
+                char e = ++i < pattern.size() ? pattern[i] : '\0';
+                size_t extra = e == 'x' ? 2 : e == 'u' ? 4 : e == 'c' ? 1 : 0;
+                if (isdigit(static_cast<unsigned char>(e)))
+                    while (i + 1 < pattern.size() && isdigit(static_cast<unsigned char>(pattern[i + 1]))) ++i;
+                i = std::min(i + extra, pattern.size());
+            }
+            break;
+        case '[':
+            flush();
+            for (++i; i < pattern.size() && pattern[i] != ']'; ++i)
+                if (pattern[i] == '\\') ++i;
+            break;
+        case '(':
+            flush();
+            ++depth;
+            break;
+        case ')':
+            flush();
+            --depth;
+            break;
+        case '?': case '*': case '{':
+            if (!run.empty()) run.pop_back(); // preceding atom is optional
+            flush();
+            if (c == '{') while (i < pattern.size() && pattern[i] != '}') ++i;
+            break;
+        case '+': case '.': case '^': case '$':
+            flush();
+            break;
+        default:
+            run.push_back(c);
+            break;
+        }
+    }
+    flush();
+    return best;
+}
+
+} // namespace minielf
@@ -0,0 +1,267 @@
+#include "minielf/NgramIndex.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <tuple>
+#include <utility>
+
+namespace minielf {
+
+namespace {
+
+/**
+ * @brief Pack three bytes into a trigram key.
+ */
+uint32_t trigramKey(const char* p) {
+    return (static_cast<uint32_t>(static_cast<unsigned char>(p[0])) << 16) |
+           (static_cast<uint32_t>(static_cast<unsigned char>(p[1])) << 8) |
+            static_cast<uint32_t>(static_cast<unsigned char>(p[2]));
+}
+
+/**
+ * @brief Collect the distinct trigram keys of a string, sorted.
+ */
+std::vector<uint32_t> distinctTrigrams(const std::string& s) {
+    std::vector<uint32_t> keys;
+    for (size_t i = 0; i + 3 <= s.size(); ++i) keys.push_back(trigramKey(&s[i]));
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    return keys;
+}
+
+/**
+ * @brief Append an unsigned LEB128 varint.
+ */
+void putVarint(std::vector<uint8_t>& out, uint32_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+/**
+ * @brief Smallest edit distance between the pattern and any substring of text
+ * (Sellers' algorithm), or maxDistance + 1 if it exceeds maxDistance.
+ */
+uint32_t substringDistance(const std::string& pattern, const std::string& text, uint32_t maxDistance) {
+    const size_t m = pattern.size();
+    std::vector<uint32_t> col(m + 1);
+    for (size_t i = 0; i <= m; ++i) col[i] = static_cast<uint32_t>(i);
+    uint32_t best = col[m];
+    for (char c : text) {
+        uint32_t diag = 0; // D[0][j-1]: a match may start anywhere in text
+        col[0] = 0;
+        for (size_t i = 1; i <= m; ++i) {
+            uint32_t up = col[i];
+            uint32_t cost = pattern[i - 1] == c ? 0 : 1;
+            col[i] = std::min({col[i - 1] + 1, up + 1, diag + cost});
+            diag = up;
+        }
+        best = std::min(best, col[m]);
+        if (best == 0) break;
+    }
+    return best <= maxDistance ? best : maxDistance + 1;
+}
+
+} // namespace
+
+/**
+ * @brief Build the index over all named symbols of an ELF file.
+ * @param elf     Parsed ELF file.
+ * @param threads Number of worker threads (0 = hardware concurrency).
+ */
+NgramIndex::NgramIndex(const MiniELF& elf, unsigned threads) : _symbols(elf.getSymbols()) {
+    // Each worker extracts (trigram, symbol) pairs for a contiguous slice of the
+    // symbol table and sorts them; slices are then merged in key order
+    const size_t count = _symbols.size();
+    const unsigned chunks = detail::resolveThreadCount(threads, count);
+    std::vector<std::vector<uint64_t>> pairs(chunks);
+    detail::parallelForEach(chunks, chunks, [&](size_t c) {
+        size_t begin = count * c / chunks;
+        size_t end = count * (c + 1) / chunks;
+        auto& out = pairs[c];
+        for (size_t i = begin; i < end; ++i) {
+            const std::string& name = _symbols[i].name;
+            for (size_t j = 0; j + 3 <= name.size(); ++j)
+                out.push_back((static_cast<uint64_t>(trigramKey(&name[j])) << 32) | i);
+        }
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    });
+
+    // K-way merge; within a key, symbol indices come out increasing, which
+    // keeps the deltas small
+    using Cursor = std::pair<uint64_t, size_t>; // (value, chunk)
+    std::priority_queue<Cursor, std::vector<Cursor>, std::greater<Cursor>> heap;
+    std::vector<size_t> pos(chunks, 0);
+    for (size_t c = 0; c < chunks; ++c)
+        if (!pairs[c].empty()) heap.push({pairs[c][0], c});
+
+    uint32_t prev = 0;
+    while (!heap.empty()) {
+        auto [value, c] = heap.top();
+        heap.pop();
+        if (++pos[c] < pairs[c].size()) heap.push({pairs[c][pos[c]], c});
+
+        uint32_t key = static_cast<uint32_t>(value >> 32);
+        uint32_t id = static_cast<uint32_t>(value);
+        if (_keys.empty() || _keys.back() != key) {
+            _keys.push_back(key);
+            _counts.push_back(0);
+            _offsets.push_back(_postings.size());
+            prev = 0;
+        }
+        putVarint(_postings, id - prev);
+        prev = id;
+        ++_counts.back();
+    }
+    _offsets.push_back(_postings.size());
+}
+
+/**
+ * @brief Decode the posting list of a trigram.
+ * @param key Trigram key.
+ * @param out Receives the symbol indices in increasing order.
+ * @return false if the trigram does not occur.
+ */
+bool NgramIndex::decode(uint32_t key, std::vector<uint32_t>& out) const {
+    out.clear();
+    auto it = std::lower_bound(_keys.begin(), _keys.end(), key);
+    if (it == _keys.end() || *it != key) return false;
+    size_t k = static_cast<size_t>(it - _keys.begin());
+    out.reserve(_counts[k]);
+    const uint8_t* p = _postings.data() + _offsets[k];
+    const uint8_t* end = _postings.data() + _offsets[k + 1];
+    uint32_t id = 0;
+    while (p < end) {
+        uint32_t delta = 0;
+        for (int shift = 0; ; shift += 7) {
+            uint8_t b = *p++;
+            delta |= static_cast<uint32_t>(b & 0x7f) << shift;
+            if (!(b & 0x80)) break;
+        }
+        id += delta;
+        out.push_back(id);
+    }
+    return true;
+}
+
+/**
+ * @brief Sort matches by rank and truncate them to limit.
+ * @param matches Matches to rank.
+ * @param pattern Query pattern.
+ * @param limit   Maximum number of results.
+ */
+void NgramIndex::rank(std::vector<SymbolMatch>& matches, const std::string& pattern,
+                      size_t limit) const {
+    auto score = [&pattern](const SymbolMatch& m) {
+        const std::string& name = m.symbol->name;
+        int kind = name == pattern ? 0 : name.compare(0, pattern.size(), pattern) == 0 ? 1 : 2;
+        return std::make_tuple(m.distance, kind, name.size());
+    };
+    auto better = [&](const SymbolMatch& a, const SymbolMatch& b) {
+        auto sa = score(a);
+        auto sb = score(b);
+        if (sa != sb) return sa < sb;
+        return a.symbol->name < b.symbol->name;
+    };
+    if (matches.size() > limit) {
+        std::partial_sort(matches.begin(), matches.begin() + limit, matches.end(), better);
+        matches.resize(limit);
+    } else {
+        std::sort(matches.begin(), matches.end(), better);
+    }
+}
+
+/**
+ * @brief Find symbols whose name contains a substring.
+ * @param pattern Substring to search for.
+ * @param limit   Maximum number of results.
+ * @return Matching symbols, best first.
+ */
+std::vector<SymbolMatch> NgramIndex::findSubstring(const std::string& pattern, size_t limit) const {
+    std::vector<SymbolMatch> matches;
+    if (pattern.size() < 3) {
+        for (const auto& sym : _symbols)
+            if (!sym.name.empty() && sym.name.find(pattern) != std::string::npos)
+                matches.push_back({&sym, 0});
+        rank(matches, pattern, limit);
+        return matches;
+    }
+
+    // Intersect posting lists, shortest first
+    std::vector<uint32_t> keys = distinctTrigrams(pattern);
+    std::vector<std::pair<uint32_t, uint32_t>> bySize; // (count, key)
+    for (uint32_t key : keys) {
+        auto it = std::lower_bound(_keys.begin(), _keys.end(), key);
+        if (it == _keys.end() || *it != key) return matches;
+        bySize.push_back({_counts[it - _keys.begin()], key});
+    }
+    std::sort(bySize.begin(), bySize.end());
+
+    std::vector<uint32_t> candidates, list, merged;
+    decode(bySize[0].second, candidates);
+    for (size_t i = 1; i < bySize.size() && !candidates.empty(); ++i) {
+        decode(bySize[i].second, list);
+        merged.clear();
+        std::set_intersection(candidates.begin(), candidates.end(), list.begin(), list.end(),
+                              std::back_inserter(merged));
+        candidates.swap(merged);
+    }
+
+    // Sharing all trigrams does not imply containment; verify
+    for (uint32_t id : candidates) {
+        const Symbol& sym = _symbols[id];
+        if (sym.name.find(pattern) != std::string::npos) matches.push_back({&sym, 0});
+    }
+    rank(matches, pattern, limit);
+    return matches;
+}
+
+/**
+ * @brief Find symbols containing a substring within a bounded edit distance.
+ * @param pattern     Substring to search for.
+ * @param maxDistance Maximum number of insertions, deletions or substitutions.
+ * @param limit       Maximum number of results.
+ * @return Matching symbols, best first.
+ */
+std::vector<SymbolMatch> NgramIndex::findFuzzy(const std::string& pattern, uint32_t maxDistance,
+                                               size_t limit) const {
+    if (maxDistance == 0) return findSubstring(pattern, limit);
+
+    std::vector<SymbolMatch> matches;
+    auto verify = [&](const Symbol& sym) {
+        if (sym.name.empty()) return;
+        uint32_t d = substringDistance(pattern, sym.name, maxDistance);
+        if (d <= maxDistance) matches.push_back({&sym, d});
+    };
+
+    // q-gram lemma: a substring within distance k of the pattern shares at
+    // least (m - 2) - 3k of the pattern's m - 2 trigrams
+    const long threshold = static_cast<long>(pattern.size()) - 2 - 3 * static_cast<long>(maxDistance);
+    if (threshold <= 0) {
+        for (const auto& sym : _symbols) verify(sym);
+        rank(matches, pattern, limit);
+        return matches;
+    }
+
+    std::vector<uint32_t> hits, list;
+    for (size_t i = 0; i + 3 <= pattern.size(); ++i) {
+        // Repeated trigrams count once per occurrence in the pattern
+        if (decode(trigramKey(&pattern[i]), list)) hits.insert(hits.end(), list.begin(), list.end());
+    }
+    std::sort(hits.begin(), hits.end());
+    for (size_t i = 0; i < hits.size();) {
+        size_t j = i;
+        while (j < hits.size() && hits[j] == hits[i]) ++j;
+        if (static_cast<long>(j - i) >= threshold) verify(_symbols[hits[i]]);
+        i = j;
+    }
+    rank(matches, pattern, limit);
+    return matches;
+}
+
+} // namespace minielf
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace minielf {
+namespace detail {
+
+/**
+ * @brief Resolve a requested thread count (0 = hardware concurrency).
+ * @param requested Requested number of threads.
+ * @param work      Number of work items (no more threads than items are used).
+ * @return Number of threads to run, at least 1.
+ */
+inline unsigned resolveThreadCount(unsigned requested, size_t work) {
+    unsigned threads = requested ? requested : std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    if (work < threads) threads = static_cast<unsigned>(std::max<size_t>(work, 1));
+    return threads;
+}
+
+/**
+ * @brief Run fn(index) for every index in [0, count) on a pool of threads.
+ *
+ * Items are handed out dynamically, so uneven work sizes balance across
+ * threads. The calling thread participates as one of the workers.
+ * @param count   Number of items.
+ * @param threads Number of threads (0 = hardware concurrency).
+ * @param fn      Callable invoked as fn(size_t index).
+ */
+template <typename Fn>
+void parallelForEach(size_t count, unsigned threads, Fn&& fn) {
+    threads = resolveThreadCount(threads, count);
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < count; i = next++) fn(i);
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+}
+
+} // namespace detail
+} // namespace minielf
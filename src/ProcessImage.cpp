@@ -0,0 +1,261 @@
+#include "minielf/ProcessImage.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <fstream>
+#include <sstream>
+#include <sys/auxv.h>
+#include <sys/uio.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+namespace minielf {
+
+namespace {
+
+/**
+ * @brief Get the size of a loaded image from its PT_LOAD segments.
+ * @param probe Source starting at the ELF header of the image.
+ * @return Bytes from the load base to the end of the last segment (0 if unreadable).
+ */
+uint64_t loadedImageExtent(const ByteSource& probe) {
+    Elf64_Ehdr ehdr{};
+    if (probe.readAt(0, &ehdr, sizeof(ehdr)) != sizeof(ehdr) || ehdr.e_phnum == 0 ||
+        ehdr.e_phnum == 0xffff /* PN_XNUM */) return 0;
+    std::vector<Elf64_Phdr> phdrs(ehdr.e_phnum);
+    const size_t phdrBytes = phdrs.size() * sizeof(Elf64_Phdr);
+    if (probe.readAt(ehdr.e_phoff, phdrs.data(), phdrBytes) != phdrBytes) return 0;
+
+    uint64_t extent = 0;
+    bool found = false;
+    uint64_t loadBase = 0;
+    for (const auto& ph : phdrs) {
+        if (ph.p_type != 1 /* PT_LOAD */) continue;
+        if (!found) loadBase = ph.p_vaddr - ph.p_offset;
+        found = true;
+        extent = std::max(extent, ph.p_vaddr + ph.p_memsz - loadBase);
+    }
+    return extent;
+}
+
+} // namespace
+
+/**
+ * @brief Read bytes from the target process, retrying partial transfers.
+ * @param offset Offset from the source address.
+ * @param buffer Destination buffer.
+ * @param size   Number of bytes to read.
+ * @return Number of bytes read; short if the range runs into unmapped memory.
+ */
+size_t ProcessMemorySource::readAt(uint64_t offset, void* buffer, size_t size) const {
+    if (offset >= _size) return 0;
+    size = static_cast<size_t>(std::min<uint64_t>(size, _size - offset));
+    size_t done = 0;
+    while (done < size) {
+        iovec local{static_cast<char*>(buffer) + done, size - done};
+        iovec remote{reinterpret_cast<void*>(static_cast<uintptr_t>(_address + offset + done)), size - done};
+        ssize_t n = ::process_vm_readv(_pid, &local, 1, &remote, 1, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        done += static_cast<size_t>(n);
+    }
+    return done;
+}
+
+/**
+ * @brief Perform a batch of reads with as few process_vm_readv calls as possible.
+ * @param requests Array of requests.
+ * @param count    Number of requests.
+ * @return Deferred future completing the reads.
+ */
+std::future<void> ProcessMemorySource::readBatch(ReadRequest* requests, size_t count) const {
+    return std::async(std::launch::deferred, [this, requests, count]() {
+        std::vector<iovec> local, remote;
+        for (size_t first = 0; first < count; first += IOV_MAX) {
+            const size_t last = std::min<size_t>(count, first + IOV_MAX);
+            local.clear();
+            remote.clear();
+            for (size_t i = first; i < last; ++i) {
+                ReadRequest& req = requests[i];
+                size_t size = req.offset >= _size ? 0
+                    : static_cast<size_t>(std::min<uint64_t>(req.size, _size - req.offset));
+                local.push_back({req.buffer, size});
+                remote.push_back({reinterpret_cast<void*>(static_cast<uintptr_t>(_address + req.offset)), size});
+            }
+            ssize_t n = ::process_vm_readv(_pid, local.data(), local.size(), remote.data(), remote.size(), 0);
+            size_t remaining = n > 0 ? static_cast<size_t>(n) : 0;
+
+            // The kernel fills the iovecs in order and stops at the first fault
+            for (size_t i = first; i < last; ++i) {
+                const size_t size = local[i - first].iov_len;
+                const size_t got = std::min(size, remaining);
+                remaining -= got;
+                requests[i].bytesRead = got < size
+                    ? readAt(requests[i].offset, requests[i].buffer, requests[i].size)
+                    : got;
+            }
+        }
+    });
+}
+
+/**
+ * @brief Read the memory mappings of a process.
+ * @param pid Target process ID.
+ * @return Mappings in address order.
+ */
+std::vector<ProcessMapping> ProcessImageCache::readMappings(int pid) {
+    std::vector<ProcessMapping> mappings;
+    std::ifstream maps("/proc/" + std::to_string(pid) + "/maps");
+    std::string line;
+    while (std::getline(maps, line)) {
+        // start-end perms offset dev inode [path]
+        std::istringstream in(line);
+        ProcessMapping m;
+        std::string range, dev;
+        if (!(in >> range >> m.perms >> std::hex >> m.offset >> dev >> std::dec >> m.inode)) continue;
+        size_t dash = range.find('-');
+        if (dash == std::string::npos) continue;
+        m.start = std::stoull(range.substr(0, dash), nullptr, 16);
+        m.end = std::stoull(range.substr(dash + 1), nullptr, 16);
+        std::getline(in >> std::ws, m.path);
+        mappings.push_back(std::move(m));
+    }
+    return mappings;
+}
+
+/**
+ * @brief Get the image whose ELF header is mapped at an address, parsing it on first use.
+ * @param pid         Target process ID.
+ * @param loadAddress Runtime address of the ELF header.
+ * @return Parsed image.
+ */
+std::shared_ptr<const MiniELF> ProcessImageCache::get(int pid, uint64_t loadAddress) {
+    const auto key = std::make_pair(pid, loadAddress);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _images.find(key);
+        if (it != _images.end()) return it->second;
+    }
+
+    ProcessMemorySource probe(pid, loadAddress, UINT64_MAX - loadAddress);
+    const uint64_t extent = loadedImageExtent(probe);
+
+    std::ostringstream name;
+    name << "/proc/" << pid << "/mem@0x" << std::hex << loadAddress;
+    auto image = std::make_shared<const MiniELF>(ProcessMemorySource(pid, loadAddress, extent), name.str(),
+                                                 ImageLayout::Loaded, loadAddress);
+
+    // Another thread may have parsed the same image meanwhile; keep the first
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _images.emplace(key, std::move(image)).first->second;
+}
+
+/**
+ * @brief Get the image a mapping belongs to.
+ * @param pid     Target process ID.
+ * @param mapping Any mapping of the image.
+ * @return Parsed image, or nullptr if no mapping at file offset 0 was found.
+ */
+std::shared_ptr<const MiniELF> ProcessImageCache::get(int pid, const ProcessMapping& mapping) {
+    if (mapping.offset == 0) return get(pid, mapping.start);
+
+    // The ELF header lives in the closest preceding mapping of the same file at offset 0
+    const ProcessMapping* head = nullptr;
+    const auto mappings = readMappings(pid);
+    for (const auto& m : mappings) {
+        if (m.start > mapping.start) break;
+        if (m.offset == 0 && m.inode == mapping.inode && m.path == mapping.path) head = &m;
+    }
+    return head ? get(pid, head->start) : nullptr;
+}
+
+/**
+ * @brief Find the address the vDSO is mapped at in a process.
+ * @param pid Target process ID.
+ * @return Address of the vDSO ELF header, or 0 if not found.
+ */
+uint64_t ProcessImageCache::findVdso(int pid) {
+    if (pid == static_cast<int>(::getpid())) return ::getauxval(33 /* AT_SYSINFO_EHDR */);
+
+    // The auxiliary vector is a sequence of (a_type, a_val) pairs ended by AT_NULL
+    std::ifstream auxv("/proc/" + std::to_string(pid) + "/auxv", std::ios::binary);
+    uint64_t entry[2];
+    while (auxv.read(reinterpret_cast<char*>(entry), sizeof(entry)) && entry[0] != 0 /* AT_NULL */) {
+        if (entry[0] == 33 /* AT_SYSINFO_EHDR */) return entry[1];
+    }
+    return 0;
+}
+
+/**
+ * @brief Get the vDSO image of a process, parsed once per kernel.
+ * @param pid Target process ID.
+ * @return Parsed vDSO, or nullptr if the process has none.
+ */
+std::shared_ptr<const MiniELF> ProcessImageCache::getVdso(int pid) {
+    const uint64_t address = findVdso(pid);
+    if (address == 0) return nullptr;
+
+    // The calling process reads its own vDSO directly
+    const bool self = pid == static_cast<int>(::getpid());
+    std::unique_ptr<ByteSource> probe;
+    if (self) {
+        probe.reset(new MemoryByteSource(reinterpret_cast<const void*>(static_cast<uintptr_t>(address)),
+                                         SIZE_MAX - address));
+    } else {
+        probe.reset(new ProcessMemorySource(pid, address, UINT64_MAX - address));
+    }
+    unsigned char ident[16];
+    if (probe->readAt(0, ident, sizeof(ident)) != sizeof(ident)) return nullptr;
+
+    // Every process on one kernel maps the same image per ELF class (compat
+    // processes get a 32-bit vDSO), so the kernel build identifies it
+    struct utsname uts{};
+    ::uname(&uts);
+    const std::string key = std::string(uts.release) + ' ' + uts.version + ' ' + uts.machine +
+                            " class " + std::to_string(ident[4]);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _vdsoImages.find(key);
+        if (it != _vdsoImages.end()) return it->second;
+    }
+
+    const uint64_t extent = loadedImageExtent(*probe);
+    std::shared_ptr<const MiniELF> image;
+    if (self) {
+        MemoryByteSource source(reinterpret_cast<const void*>(static_cast<uintptr_t>(address)),
+                                static_cast<size_t>(extent));
+        image = std::make_shared<const MiniELF>(source, "[vdso]", ImageLayout::Loaded, address);
+    } else {
+        image = std::make_shared<const MiniELF>(ProcessMemorySource(pid, address, extent), "[vdso]",
+                                                ImageLayout::Loaded, address);
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _vdsoImages.emplace(key, std::move(image)).first->second;
+}
+
+/**
+ * @brief Drop the cached images of a process.
+ * @param pid Target process ID.
+ */
+void ProcessImageCache::invalidate(int pid) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto first = _images.lower_bound(std::make_pair(pid, uint64_t(0)));
+    auto last = _images.lower_bound(std::make_pair(pid + 1, uint64_t(0)));
+    _images.erase(first, last);
+}
+
+/**
+ * @brief Get the number of cached process images.
+ * @return Number of (pid, load address) entries, not counting vDSO images.
+ */
+size_t ProcessImageCache::size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _images.size();
+}
+
+} // namespace minielf
@@ -0,0 +1,326 @@
+#include "minielf/SizeReport.hpp"
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+
+namespace minielf {
+
+namespace {
+
+constexpr uint32_t NoRange = static_cast<uint32_t>(-1);
+
+/**
+ * @brief Half-open byte range [start, end) with an owner id.
+ */
+struct Range {
+    uint64_t start;
+    uint64_t end;
+    uint32_t id;
+};
+
+/**
+ * @brief Saturating end of a range, so malformed sizes cannot wrap around.
+ */
+uint64_t rangeEnd(uint64_t start, uint64_t size) {
+    return size > UINT64_MAX - start ? UINT64_MAX : start + size;
+}
+
+/**
+ * @brief Tracks which of a set of ranges covers a position during an upward sweep.
+ *
+ * When ranges overlap, the one starting first (then the first added) wins.
+ */
+class ActiveRange {
+public:
+    explicit ActiveRange(std::vector<Range> ranges) : _ranges(std::move(ranges)) {
+        std::stable_sort(_ranges.begin(), _ranges.end(),
+            [](const Range& a, const Range& b) { return a.start < b.start; });
+    }
+
+    /**
+     * @brief Get the id of the range covering a position.
+     * @param pos Position, not lower than in the previous call.
+     * @return Range id, or NoRange.
+     */
+    uint32_t at(uint64_t pos) {
+        while (_next < _ranges.size() && _ranges[_next].start <= pos) _active.push(_next++);
+        while (!_active.empty() && _ranges[_active.top()].end <= pos) _active.pop();
+        return _active.empty() ? NoRange : _ranges[_active.top()].id;
+    }
+
+    /**
+     * @brief Append the start and end of every range.
+     */
+    void addBoundaries(std::vector<uint64_t>& points) const {
+        for (const auto& r : _ranges) {
+            points.push_back(r.start);
+            points.push_back(r.end);
+        }
+    }
+
+private:
+    std::vector<Range> _ranges;
+    size_t _next = 0;
+    std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> _active;
+};
+
+/**
+ * @brief Split [lo, hi) at every range boundary and report each piece once.
+ *
+ * emit(length, region, container) receives the ids of the covering region
+ * and container, or NoRange.
+ */
+template <typename Emit>
+void sweep(std::vector<Range> regions, std::vector<Range> containers, uint64_t lo, uint64_t hi, Emit emit) {
+    ActiveRange activeRegions(std::move(regions));
+    ActiveRange activeContainers(std::move(containers));
+    std::vector<uint64_t> points{lo, hi};
+    activeRegions.addBoundaries(points);
+    activeContainers.addBoundaries(points);
+    std::sort(points.begin(), points.end());
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    for (size_t k = 0; k + 1 < points.size(); ++k) {
+        if (points[k] < lo || points[k + 1] > hi) continue;
+        emit(points[k + 1] - points[k], activeRegions.at(points[k]), activeContainers.at(points[k]));
+    }
+}
+
+/**
+ * @brief Check whether a symbol takes part in the attribution.
+ */
+bool claimsBytes(const Symbol& sym) {
+    // TLS symbol values are offsets into the TLS block, not addresses
+    return sym.size != 0 && sym.type != SymbolType::SECTION && sym.type != SymbolType::FILE &&
+           sym.type != SymbolType::TLS;
+}
+
+/**
+ * @brief Gives the bytes of sections to address-ordered symbols.
+ *
+ * Symbols are visited once in address order. Each claims the bytes of its
+ * range no earlier symbol claimed; a symbol reaching past the end of a
+ * section continues into the following sections.
+ */
+class SymbolClaimer {
+public:
+    explicit SymbolClaimer(std::vector<SymbolSize>& out) : _out(out) {}
+
+    /**
+     * @brief Attribute the bytes of one section, appending its entries and gap entry.
+     * @param it      Next unvisited symbol; advanced past the symbols starting before hi.
+     * @param end     End of the address-ordered symbols.
+     * @param lo      Section start address.
+     * @param hi      Section end address.
+     * @param section Section entry index.
+     * @param inFile  Whether the section occupies file bytes.
+     */
+    void claim(const Symbol* const*& it, const Symbol* const* end, uint64_t lo, uint64_t hi,
+               size_t section, bool inFile) {
+        uint64_t cursor = lo;
+        uint64_t gap = 0;
+        auto give = [&](const Symbol* sym, uint64_t upTo) {
+            if (upTo <= cursor) return;
+            const uint64_t n = upTo - cursor;
+            _out.push_back({sym, section, n, inFile ? n : 0});
+            cursor = upTo;
+        };
+        if (_carry && _carryEnd > cursor) give(_carry, std::min(_carryEnd, hi));
+        for (; it != end && (*it)->address < hi; ++it) {
+            const Symbol* sym = *it;
+            if (!claimsBytes(*sym)) continue;
+            const uint64_t symEnd = rangeEnd(sym->address, sym->size);
+            if (symEnd > _carryEnd) {
+                _carry = sym;
+                _carryEnd = symEnd;
+            }
+            if (symEnd <= cursor) continue;
+            if (sym->address > cursor) {
+                gap += sym->address - cursor;
+                cursor = sym->address;
+            }
+            give(sym, std::min(symEnd, hi));
+        }
+        gap += hi - cursor;
+        _out.push_back({nullptr, section, gap, inFile ? gap : 0});
+    }
+
+private:
+    std::vector<SymbolSize>& _out;
+    const Symbol* _carry = nullptr; ///< Visited symbol reaching furthest
+    uint64_t _carryEnd = 0;
+};
+
+/**
+ * @brief Name a loadable segment after its index and permissions, e.g. "LOAD #2 [RX]".
+ */
+std::string segmentName(const Elf64_Phdr& ph, size_t index) {
+    std::string flags;
+    if (ph.p_flags & 4 /* PF_R */) flags += 'R';
+    if (ph.p_flags & 2 /* PF_W */) flags += 'W';
+    if (ph.p_flags & 1 /* PF_X */) flags += 'X';
+    return "LOAD #" + std::to_string(index) + " [" + flags + "]";
+}
+
+} // namespace
+
+/**
+ * @brief Attribute the bytes of a parsed file.
+ * @param elf Parsed ELF file.
+ */
+SizeReport::SizeReport(const MiniELF& elf) {
+    const auto& shdrs = elf.getSectionHeaders();
+    const auto& phdrs = elf.getProgramHeaders();
+    const auto& ehdr = elf.getRawHeader();
+    _fileSize = elf.getFileSize();
+
+    // Segments: PT_LOAD in header order, then everything else
+    std::vector<Range> fileSegments, vmSegments;
+    for (size_t i = 0; i < phdrs.size(); ++i) {
+        const auto& ph = phdrs[i];
+        if (ph.p_type != 1 /* PT_LOAD */) continue;
+        const uint32_t id = static_cast<uint32_t>(_segments.size());
+        _segments.push_back({segmentName(ph, i), 0, 0, SizeEntry::NoParent});
+        if (ph.p_filesz) fileSegments.push_back({ph.p_offset, rangeEnd(ph.p_offset, ph.p_filesz), id});
+        if (ph.p_memsz) vmSegments.push_back({ph.p_vaddr, rangeEnd(ph.p_vaddr, ph.p_memsz), id});
+    }
+    const size_t unmapped = _segments.size();
+    _segments.push_back({"[Unmapped]", 0, 0, SizeEntry::NoParent});
+
+    // Regions: sections by index, then the headers. TLS .tbss takes no space
+    // in the image (it overlaps the sections after it), so it has no VM range.
+    const uint32_t sectionCount = static_cast<uint32_t>(shdrs.size());
+    const uint32_t elfHeader = sectionCount, programHeaders = sectionCount + 1, sectionHeaders = sectionCount + 2;
+    std::vector<Range> fileRegions, vmRegions, allocated;
+    for (uint32_t i = 0; i < sectionCount; ++i) {
+        const auto& sh = shdrs[i];
+        if (sh.sh_type == 0 /* SHT_NULL */ || sh.sh_size == 0) continue;
+        const bool nobits = sh.sh_type == 8 /* SHT_NOBITS */;
+        if (!nobits) fileRegions.push_back({sh.sh_offset, rangeEnd(sh.sh_offset, sh.sh_size), i});
+        if ((sh.sh_flags & 0x2 /* SHF_ALLOC */) && !(nobits && (sh.sh_flags & 0x400 /* SHF_TLS */))) {
+            vmRegions.push_back({sh.sh_addr, rangeEnd(sh.sh_addr, sh.sh_size), i});
+        }
+    }
+    allocated = vmRegions;
+    const Range headers[] = {
+        {0, ehdr.e_ehsize, elfHeader},
+        {ehdr.e_phoff, rangeEnd(ehdr.e_phoff, phdrs.size() * sizeof(Elf64_Phdr)), programHeaders},
+        {ehdr.e_shoff, rangeEnd(ehdr.e_shoff, shdrs.size() * sizeof(Elf64_Shdr)), sectionHeaders},
+    };
+    for (const auto& h : headers) {
+        if (h.end <= h.start) continue;
+        fileRegions.push_back(h);
+        // Headers inside a loadable segment are mapped too
+        for (const auto& ph : phdrs) {
+            if (ph.p_type != 1 /* PT_LOAD */ || h.start < ph.p_offset || h.start - ph.p_offset >= ph.p_filesz) continue;
+            const uint64_t mapped = std::min(h.end - h.start, ph.p_filesz - (h.start - ph.p_offset));
+            const uint64_t vmStart = ph.p_vaddr + (h.start - ph.p_offset);
+            vmRegions.push_back({vmStart, rangeEnd(vmStart, mapped), h.id});
+            break;
+        }
+    }
+
+    // Section level entries are keyed by (region, segment)
+    const auto& sections = elf.getSections();
+    std::unordered_map<uint64_t, size_t> entryIndex;
+    std::vector<uint32_t> entryRegion;
+    auto entry = [&](uint32_t region, size_t segment) -> SizeEntry& {
+        auto [it, inserted] = entryIndex.emplace((uint64_t(region) << 32) | segment, _sections.size());
+        if (inserted) {
+            std::string name;
+            if (region == NoRange) name = segment == unmapped ? "[Unmapped]" : "[" + _segments[segment].name + "]";
+            else if (region == elfHeader) name = "[ELF header]";
+            else if (region == programHeaders) name = "[Program headers]";
+            else if (region == sectionHeaders) name = "[Section headers]";
+            else if (region < sections.size() && !sections[region].name.empty()) name = sections[region].name;
+            else name = "[section " + std::to_string(region) + "]";
+            _sections.push_back({std::move(name), 0, 0, segment});
+            entryRegion.push_back(region);
+        }
+        return _sections[it->second];
+    };
+
+    sweep(fileRegions, fileSegments, 0, _fileSize, [&](uint64_t n, uint32_t region, uint32_t segment) {
+        entry(region, segment == NoRange ? unmapped : segment).fileSize += n;
+    });
+    if (!vmSegments.empty()) {
+        uint64_t lo = UINT64_MAX, hi = 0;
+        for (const auto& r : vmSegments) {
+            lo = std::min(lo, r.start);
+            hi = std::max(hi, r.end);
+        }
+        sweep(vmRegions, vmSegments, lo, hi, [&](uint64_t n, uint32_t region, uint32_t segment) {
+            if (segment != NoRange) entry(region, segment).vmSize += n;
+        });
+    } else {
+        // Relocatable objects: allocated sections all start at 0 and are counted whole
+        for (const auto& r : allocated) entry(r.id, unmapped).vmSize += r.end - r.start;
+    }
+
+    // Group section entries by segment (the bucket of bytes no section
+    // covers last) and roll them up
+    std::vector<size_t> order(_sections.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if (_sections[a].parent != _sections[b].parent) return _sections[a].parent < _sections[b].parent;
+        return entryRegion[a] != NoRange && entryRegion[b] == NoRange;
+    });
+    std::vector<SizeEntry> grouped;
+    std::vector<size_t> sectionEntry(sectionCount, SizeEntry::NoParent);
+    grouped.reserve(order.size());
+    for (size_t i : order) {
+        const uint32_t region = entryRegion[i];
+        if (region < sectionCount && sectionEntry[region] == SizeEntry::NoParent) sectionEntry[region] = grouped.size();
+        grouped.push_back(std::move(_sections[i]));
+        auto& segment = _segments[grouped.back().parent];
+        segment.vmSize += grouped.back().vmSize;
+        segment.fileSize += grouped.back().fileSize;
+    }
+    _sections = std::move(grouped);
+    for (const auto& segment : _segments) _vmSize += segment.vmSize;
+
+    // Symbols: one sweep over the address index (per section for objects,
+    // whose sections all start at address 0)
+    std::stable_sort(allocated.begin(), allocated.end(),
+        [](const Range& a, const Range& b) { return a.start < b.start; });
+    std::vector<SymbolSize> claimed;
+    std::vector<std::pair<size_t, size_t>> runs(_sections.size(), {0, 0});
+    const SymbolSpan byAddress = elf.getSymbolsSortedByAddress();
+    const Symbol* const* it = byAddress.begin();
+    SymbolClaimer linked(claimed);
+    for (const auto& r : allocated) {
+        const size_t section = sectionEntry[r.id];
+        if (section == SizeEntry::NoParent) continue;
+        const bool inFile = shdrs[r.id].sh_type != 8 /* SHT_NOBITS */;
+        const size_t first = claimed.size();
+        if (elf.isRelocatable()) {
+            const SymbolSpan inSection = elf.getSymbolsInSection(r.id);
+            const Symbol* const* sectionIt = inSection.begin();
+            SymbolClaimer(claimed).claim(sectionIt, inSection.end(), r.start, r.end, section, inFile);
+        } else {
+            linked.claim(it, byAddress.end(), r.start, r.end, section, inFile);
+        }
+        runs[section] = {first, claimed.size()};
+    }
+
+    // Order the per-section runs like the section entries
+    _symbols.reserve(claimed.size());
+    _symbolOffsets.reserve(_sections.size() + 1);
+    for (const auto& run : runs) {
+        _symbolOffsets.push_back(_symbols.size());
+        _symbols.insert(_symbols.end(), claimed.begin() + run.first, claimed.begin() + run.second);
+    }
+    _symbolOffsets.push_back(_symbols.size());
+}
+
+/**
+ * @brief Get the symbol entries of one section entry.
+ * @param section Index into getSections().
+ * @return View of the symbol entries, gap entry last (empty for unallocated sections).
+ */
+Span<SymbolSize> SizeReport::getSymbolsInSection(size_t section) const {
+    if (section + 1 >= _symbolOffsets.size()) return {};
+    return Span<SymbolSize>(_symbols.data() + _symbolOffsets[section], _symbols.data() + _symbolOffsets[section + 1]);
+}
+
+} // namespace minielf
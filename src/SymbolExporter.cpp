@@ -0,0 +1,232 @@
+#include "minielf/SymbolExporter.hpp"
+#include <fstream>
+#include <ostream>
+#include <string.h>
+
+namespace minielf {
+
+namespace {
+
+/**
+ * @brief Append-only output buffer flushed to a stream in large blocks.
+ */
+class BufferedWriter {
+public:
+    explicit BufferedWriter(std::ostream& out) : _out(out) {}
+    ~BufferedWriter() { flush(); }
+
+    void put(char c) {
+        if (_used == sizeof(_buffer)) flush();
+        _buffer[_used++] = c;
+    }
+
+    void put(const char* data, size_t size) {
+        if (size > sizeof(_buffer) - _used) {
+            flush();
+            if (size > sizeof(_buffer)) {
+                _out.write(data, static_cast<std::streamsize>(size));
+                return;
+            }
+        }
+        memcpy(_buffer + _used, data, size);
+        _used += size;
+    }
+
+    void put(const std::string& s) { put(s.data(), s.size()); }
+
+    /**
+     * @brief Append a value in lowercase hex, zero padded to at least width digits.
+     */
+    void putHex(uint64_t value, int width = 1) {
+        static const char digits[] = "0123456789abcdef";
+        char tmp[16];
+        int n = 0;
+        do {
+            tmp[15 - n++] = digits[value & 0xf];
+            value >>= 4;
+        } while (value != 0);
+        while (n < width && n < 16) tmp[15 - n++] = '0';
+        put(tmp + 16 - n, static_cast<size_t>(n));
+    }
+
+    void flush() {
+        if (_used) _out.write(_buffer, static_cast<std::streamsize>(_used));
+        _used = 0;
+    }
+
+private:
+    std::ostream& _out;
+    char _buffer[1 << 16];
+    size_t _used = 0;
+};
+
+/**
+ * @brief Check whether a symbol names something worth exporting.
+ */
+bool isExportable(const Symbol& sym) {
+    return !sym.name.empty() && sym.sectionIndex != 0 /* SHN_UNDEF */ &&
+           sym.type != SymbolType::SECTION && sym.type != SymbolType::FILE;
+}
+
+/**
+ * @brief Name of a symbol type in the symbol list format.
+ */
+const char* typeName(SymbolType type) {
+    switch (type) {
+    case SymbolType::NOTYPE: return "NOTYPE";
+    case SymbolType::OBJECT: return "OBJECT";
+    case SymbolType::FUNC:   return "FUNC";
+    case SymbolType::COMMON: return "COMMON";
+    case SymbolType::TLS:    return "TLS";
+    default:                 return "UNKNOWN";
+    }
+}
+
+/**
+ * @brief Breakpad architecture name of an ELF machine type.
+ */
+const char* breakpadArch(uint16_t machine) {
+    switch (machine) {
+    case 3:   return "x86";     // EM_386
+    case 8:   return "mips64";  // EM_MIPS
+    case 21:  return "ppc64";   // EM_PPC64
+    case 40:  return "arm";     // EM_ARM
+    case 62:  return "x86_64";  // EM_X86_64
+    case 183: return "arm64";   // EM_AARCH64
+    case 243: return "riscv64"; // EM_RISCV
+    default:  return "unknown";
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Compute the Breakpad module ID of a build ID.
+ * @param buildId GNU build ID bytes.
+ * @return 33-character module ID.
+ */
+std::string SymbolExporter::breakpadModuleId(const std::vector<uint8_t>& buildId) {
+    uint8_t guid[16] = {};
+    if (!buildId.empty()) memcpy(guid, buildId.data(), buildId.size() < 16 ? buildId.size() : 16);
+    // GUID fields data1 (4 bytes), data2 and data3 (2 bytes each) are little-endian
+    static const int order[16] = {3, 2, 1, 0, 5, 4, 7, 6, 8, 9, 10, 11, 12, 13, 14, 15};
+    static const char digits[] = "0123456789ABCDEF";
+    std::string id;
+    for (int i : order) {
+        id.push_back(digits[guid[i] >> 4]);
+        id.push_back(digits[guid[i] & 0xf]);
+    }
+    id.push_back('0'); // age
+    return id;
+}
+
+/**
+ * @brief Check whether the file can be exported in a given format.
+ * @param format Output format.
+ * @return false for Breakpad if the file has no build ID, true otherwise.
+ */
+bool SymbolExporter::canWrite(ExportFormat format) const {
+    return format != ExportFormat::Breakpad || !_elf.getBuildId().empty();
+}
+
+/**
+ * @brief Write all records in a given format.
+ * @param out    Output stream.
+ * @param format Output format.
+ * @param bias   Value added to every address (perf map and symbol list).
+ * @return Number of records written, excluding headers.
+ */
+size_t SymbolExporter::write(std::ostream& out, ExportFormat format, uint64_t bias) const {
+    BufferedWriter w(out);
+    size_t records = 0;
+    const SymbolSpan symbols = _elf.getSymbolsSortedByAddress();
+
+    switch (format) {
+    case ExportFormat::PerfMap:
+        for (const Symbol* sym : symbols) {
+            if (!sym->isFunction() || sym->size == 0 || !isExportable(*sym)) continue;
+            w.putHex(sym->address + bias);
+            w.put(' ');
+            w.putHex(sym->size);
+            w.put(' ');
+            w.put(sym->name);
+            w.put('\n');
+            ++records;
+        }
+        break;
+
+    case ExportFormat::Breakpad: {
+        // Without a build ID every module would share the all-zero ID in a symbol store
+        if (_elf.getBuildId().empty()) break;
+        // Addresses are relative to the first PT_LOAD segment, as dump_syms does
+        uint64_t loadAddress = 0;
+        for (const auto& ph : _elf.getProgramHeaders()) {
+            if (ph.p_type == 1 /* PT_LOAD */) {
+                loadAddress = ph.p_vaddr;
+                break;
+            }
+        }
+        const std::string& path = _elf.getFilePath();
+        const std::string name = path.substr(path.find_last_of('/') + 1);
+        const auto& buildId = _elf.getBuildId();
+        w.put("MODULE Linux ");
+        w.put(breakpadArch(_elf.getMetadata().machine));
+        w.put(' ');
+        w.put(breakpadModuleId(buildId));
+        w.put(' ');
+        w.put(name);
+        w.put('\n');
+        w.put("INFO CODE_ID ");
+        for (uint8_t b : buildId) w.putHex(b, 2);
+        w.put('\n');
+
+        uint64_t lastAddress = 0;
+        for (const Symbol* sym : symbols) {
+            if (!sym->isFunction() || !isExportable(*sym) || sym->address < loadAddress) continue;
+            if (records != 0 && sym->address == lastAddress) continue; // one name per address
+            lastAddress = sym->address;
+            w.put("PUBLIC ");
+            w.putHex(sym->address - loadAddress);
+            w.put(" 0 ");
+            w.put(sym->name);
+            w.put('\n');
+            ++records;
+        }
+        break;
+    }
+
+    case ExportFormat::SymbolList:
+        for (const Symbol* sym : symbols) {
+            if (!isExportable(*sym)) continue;
+            w.putHex(sym->address + bias, 16);
+            w.put(' ');
+            w.putHex(sym->size, 16);
+            w.put(' ');
+            w.put(typeName(sym->type));
+            w.put(' ');
+            w.put(sym->name);
+            w.put('\n');
+            ++records;
+        }
+        break;
+    }
+    return records;
+}
+
+/**
+ * @brief Write all records to a file.
+ * @param path   Output file path.
+ * @param format Output format.
+ * @param bias   Value added to every address.
+ * @return true if the file was written completely, false otherwise.
+ */
+bool SymbolExporter::writeFile(const std::string& path, ExportFormat format, uint64_t bias) const {
+    if (!canWrite(format)) return false;
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    write(out, format, bias);
+    out.flush();
+    return static_cast<bool>(out);
+}
+
+} // namespace minielf
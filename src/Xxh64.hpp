@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string.h>
+
+namespace minielf {
+namespace detail {
+
+/**
+ * @brief Streaming XXH64 hash (xxHash, 64-bit variant).
+ *
+ * The output matches the reference implementation (xxhsum -H1), so hashes
+ * can be compared with other tools. The bulk loop keeps four independent
+ * accumulator lanes over 32-byte stripes, which lets the CPU overlap the
+ * multiplications of consecutive lanes.
+ */
+class Xxh64 {
+public:
+    /**
+     * @brief Start a hash.
+     * @param seed Hash seed.
+     */
+    explicit Xxh64(uint64_t seed = 0) : _seed(seed) {
+        _lanes[0] = seed + Prime1 + Prime2;
+        _lanes[1] = seed + Prime2;
+        _lanes[2] = seed;
+        _lanes[3] = seed - Prime1;
+    }
+
+    /**
+     * @brief Hash more bytes.
+     * @param data Pointer to the bytes.
+     * @param size Number of bytes.
+     */
+    void update(const void* data, size_t size) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        _total += size;
+        if (_buffered + size < 32) {
+            memcpy(_buffer + _buffered, p, size);
+            _buffered += size;
+            return;
+        }
+        if (_buffered) {
+            const size_t fill = 32 - _buffered;
+            memcpy(_buffer + _buffered, p, fill);
+            stripe(_buffer);
+            p += fill;
+            size -= fill;
+            _buffered = 0;
+        }
+        const unsigned char* end = p + size - size % 32;
+        uint64_t a = _lanes[0], b = _lanes[1], c = _lanes[2], d = _lanes[3];
+        for (; p < end; p += 32) {
+            a = round(a, read64(p));
+            b = round(b, read64(p + 8));
+            c = round(c, read64(p + 16));
+            d = round(d, read64(p + 24));
+        }
+        _lanes[0] = a; _lanes[1] = b; _lanes[2] = c; _lanes[3] = d;
+        _buffered = size % 32;
+        memcpy(_buffer, p, _buffered);
+    }
+
+    /**
+     * @brief Get the hash of the bytes so far.
+     * @return 64-bit hash value.
+     */
+    uint64_t digest() const {
+        uint64_t h;
+        if (_total >= 32) {
+            h = rotl(_lanes[0], 1) + rotl(_lanes[1], 7) + rotl(_lanes[2], 12) + rotl(_lanes[3], 18);
+            for (uint64_t lane : _lanes) h = (h ^ round(0, lane)) * Prime1 + Prime4;
+        } else {
+            h = _seed + Prime5;
+        }
+        h += _total;
+
+        const unsigned char* p = _buffer;
+        const unsigned char* end = _buffer + _buffered;
+        for (; p + 8 <= end; p += 8) h = rotl(h ^ round(0, read64(p)), 27) * Prime1 + Prime4;
+        if (p + 4 <= end) {
+            uint32_t v;
+            memcpy(&v, p, 4);
+            h = rotl(h ^ (uint64_t(v) * Prime1), 23) * Prime2 + Prime3;
+            p += 4;
+        }
+        for (; p < end; ++p) h = rotl(h ^ (*p * Prime5), 11) * Prime1;
+
+        h ^= h >> 33;
+        h *= Prime2;
+        h ^= h >> 29;
+        h *= Prime3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    /**
+     * @brief Hash a buffer in one call.
+     * @param data Pointer to the bytes.
+     * @param size Number of bytes.
+     * @param seed Hash seed.
+     * @return 64-bit hash value.
+     */
+    static uint64_t hash(const void* data, size_t size, uint64_t seed = 0) {
+        Xxh64 h(seed);
+        h.update(data, size);
+        return h.digest();
+    }
+
+private:
+    static constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+    static constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+    static constexpr uint64_t Prime3 = 0x165667B19E3779F9ULL;
+    static constexpr uint64_t Prime4 = 0x85EBCA77C2B2AE63ULL;
+    static constexpr uint64_t Prime5 = 0x27D4EB2F165667C5ULL;
+
+    static uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+    static uint64_t read64(const unsigned char* p) {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        return v;
+    }
+    static uint64_t round(uint64_t acc, uint64_t input) {
+        acc += input * Prime2;
+        return rotl(acc, 31) * Prime1;
+    }
+    void stripe(const unsigned char* p) {
+        for (int i = 0; i < 4; ++i) _lanes[i] = round(_lanes[i], read64(p + i * 8));
+    }
+
+    uint64_t _seed;
+    uint64_t _lanes[4];
+    uint64_t _total = 0;
+    unsigned char _buffer[32];
+    size_t _buffered = 0;
+};
+
+} // namespace detail
+} // namespace minielf
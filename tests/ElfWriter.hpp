@@ -0,0 +1,195 @@
+#pragma once
+
+/**
+ * @file ElfWriter.hpp
+ * @brief Minimal ELF64 writer used by the tests to generate synthetic inputs.
+ *
+ * Builds little-endian ELF64 images with arbitrary sections and a .symtab.
+ * Section 0, .shstrtab, .symtab, .strtab (and .symtab_shndx when needed) are
+ * added automatically; extended numbering is used once the section count or a
+ * symbol's section index reaches SHN_LORESERVE.
+ */
+
+#include "minielf/MiniELF.hpp"
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace minielf_test {
+
+class ElfWriter {
+public:
+    struct SectionSpec {
+        std::string name;
+        uint32_t type = 1;      // SHT_PROGBITS
+        uint64_t flags = 0;
+        uint64_t address = 0;
+        std::string data;       // contents (ignored for SHT_NOBITS)
+        uint64_t size = 0;      // size for SHT_NOBITS sections
+    };
+
+    struct SymbolSpec {
+        std::string name;
+        uint64_t value = 0;
+        uint64_t size = 0;
+        uint8_t info = 0x12;    // STB_GLOBAL | STT_FUNC
+        uint32_t section = 0;   // index from addSection(), or 0xffff0000|SHN_xxx for reserved indices
+    };
+
+    explicit ElfWriter(uint16_t type = 1 /* ET_REL */) : _type(type) {}
+
+    /// Adds a section and returns its final section header index.
+    uint32_t addSection(const SectionSpec& sec) {
+        _sections.push_back(sec);
+        return static_cast<uint32_t>(_sections.size()); // index 0 is the null section
+    }
+
+    void addSymbol(const SymbolSpec& sym) { _symbols.push_back(sym); }
+
+    /// Reuse the tail of an already written name when a name is a suffix of it,
+    /// like linkers do when merging string tables.
+    void setTailMerge(bool enabled) { _tailMerge = enabled; }
+
+    std::string build() const {
+        const uint32_t shnReserve = 0xff00;
+        const uint32_t userCount = static_cast<uint32_t>(_sections.size());
+        bool needShndx = false;
+        auto isReserved = [](uint32_t section) { return section >= 0xffff0000u; };
+        for (const auto& s : _symbols)
+            needShndx = needShndx || (s.section >= shnReserve && !isReserved(s.section));
+        const uint32_t shstrndx = userCount + 1;
+        const uint32_t symtabndx = userCount + 2;
+        const uint32_t strtabndx = userCount + 3;
+        const uint32_t shndxndx = userCount + 4;
+        const uint32_t total = userCount + 4 + (needShndx ? 1 : 0);
+        const bool extended = total >= shnReserve;
+
+        std::string shstr(1, '\0');
+        auto addName = [&shstr](const std::string& name) {
+            uint32_t off = static_cast<uint32_t>(shstr.size());
+            shstr += name;
+            shstr.push_back('\0');
+            return off;
+        };
+
+        std::string strtab(1, '\0');
+        std::string symtab(sizeof(minielf::Elf64_Sym), '\0');
+        std::string shndx(needShndx ? 4 : 0, '\0');
+        for (const auto& s : _symbols) {
+            minielf::Elf64_Sym sym{};
+            size_t existing = _tailMerge && !s.name.empty()
+                ? strtab.find(s.name + '\0') : std::string::npos;
+            if (existing != std::string::npos) {
+                sym.st_name = static_cast<uint32_t>(existing);
+            } else {
+                sym.st_name = static_cast<uint32_t>(strtab.size());
+                strtab += s.name;
+                strtab.push_back('\0');
+            }
+            sym.st_info = s.info;
+            if (isReserved(s.section)) sym.st_shndx = static_cast<uint16_t>(s.section);
+            else if (s.section >= shnReserve) sym.st_shndx = 0xffff; // SHN_XINDEX
+            else sym.st_shndx = static_cast<uint16_t>(s.section);
+            sym.st_value = s.value;
+            sym.st_size = s.size;
+            symtab.append(reinterpret_cast<const char*>(&sym), sizeof(sym));
+            if (needShndx) {
+                uint32_t idx = isReserved(s.section) ? 0 : s.section;
+                shndx.append(reinterpret_cast<const char*>(&idx), 4);
+            }
+        }
+
+        std::vector<minielf::Elf64_Shdr> shdrs(total);
+        std::string out(sizeof(minielf::Elf64_Ehdr), '\0');
+        auto place = [&out](minielf::Elf64_Shdr& sh, const std::string& bytes, uint64_t align) {
+            while (out.size() % align) out.push_back('\0');
+            sh.sh_offset = out.size();
+            sh.sh_size = bytes.size();
+            out += bytes;
+        };
+
+        for (uint32_t i = 0; i < userCount; ++i) {
+            const auto& spec = _sections[i];
+            auto& sh = shdrs[i + 1];
+            sh.sh_name = addName(spec.name);
+            sh.sh_type = spec.type;
+            sh.sh_flags = spec.flags;
+            sh.sh_addr = spec.address;
+            sh.sh_addralign = 1;
+            if (spec.type == 8 /* SHT_NOBITS */) {
+                sh.sh_offset = out.size();
+                sh.sh_size = spec.size;
+            } else {
+                place(sh, spec.data, 1);
+            }
+        }
+
+        auto& symSh = shdrs[symtabndx];
+        symSh.sh_name = addName(".symtab");
+        symSh.sh_type = 2; // SHT_SYMTAB
+        symSh.sh_link = strtabndx;
+        symSh.sh_info = 1;
+        symSh.sh_entsize = sizeof(minielf::Elf64_Sym);
+        symSh.sh_addralign = 8;
+        place(symSh, symtab, 8);
+
+        auto& strSh = shdrs[strtabndx];
+        strSh.sh_name = addName(".strtab");
+        strSh.sh_type = 3; // SHT_STRTAB
+        strSh.sh_addralign = 1;
+        place(strSh, strtab, 1);
+
+        if (needShndx) {
+            auto& xSh = shdrs[shndxndx];
+            xSh.sh_name = addName(".symtab_shndx");
+            xSh.sh_type = 18; // SHT_SYMTAB_SHNDX
+            xSh.sh_link = symtabndx;
+            xSh.sh_entsize = 4;
+            xSh.sh_addralign = 4;
+            place(xSh, shndx, 4);
+        }
+
+        auto& shstrSh = shdrs[shstrndx];
+        shstrSh.sh_name = addName(".shstrtab");
+        shstrSh.sh_type = 3; // SHT_STRTAB
+        shstrSh.sh_addralign = 1;
+        place(shstrSh, shstr, 1);
+
+        if (extended) {
+            shdrs[0].sh_size = total;
+            shdrs[0].sh_link = shstrndx;
+        }
+
+        while (out.size() % 8) out.push_back('\0');
+        minielf::Elf64_Ehdr ehdr{};
+        const unsigned char ident[16] = {0x7f, 'E', 'L', 'F', 2, 1, 1};
+        std::memcpy(ehdr.e_ident, ident, sizeof(ident));
+        ehdr.e_type = _type;
+        ehdr.e_machine = 62; // EM_X86_64
+        ehdr.e_version = 1;
+        ehdr.e_shoff = out.size();
+        ehdr.e_ehsize = sizeof(minielf::Elf64_Ehdr);
+        ehdr.e_shentsize = sizeof(minielf::Elf64_Shdr);
+        ehdr.e_shnum = extended ? 0 : static_cast<uint16_t>(total);
+        ehdr.e_shstrndx = extended ? 0xffff /* SHN_XINDEX */ : static_cast<uint16_t>(shstrndx);
+        out.append(reinterpret_cast<const char*>(shdrs.data()), shdrs.size() * sizeof(minielf::Elf64_Shdr));
+        std::memcpy(&out[0], &ehdr, sizeof(ehdr));
+        return out;
+    }
+
+    bool write(const std::string& path) const {
+        std::ofstream file(path, std::ios::binary);
+        std::string bytes = build();
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        return static_cast<bool>(file);
+    }
+
+private:
+    uint16_t _type;
+    bool _tailMerge = false;
+    std::vector<SectionSpec> _sections;
+    std::vector<SymbolSpec> _symbols;
+};
+
+} // namespace minielf_test
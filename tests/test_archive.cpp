@@ -0,0 +1,131 @@
+#include "minielf/MiniArchive.hpp"
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/**
+ * @file test_archive.cpp
+ * @brief Unit tests for the MiniArchive reader.
+ *
+ * The tests ensure that:
+ *   - A GNU archive built by the toolchain lists its members, including long names.
+ *   - Members are parsed in place (sequentially and in parallel) into valid MiniELF objects.
+ *   - The archive symbol index maps symbols to their defining members.
+ *   - A BSD archive (`#1/` names, `__.SYMDEF` index) is read equivalently.
+ *   - Non-archive inputs are rejected with an error.
+ *
+ * Usage:
+ *   test_archive <gnu_archive.a> <elf_file>
+ */
+
+// Formats a 60-byte ar member header.
+static std::string arHeader(const std::string& name, size_t size) {
+    char buf[61];
+    std::snprintf(buf, sizeof(buf), "%-16s%-12s%-6s%-6s%-8s%-10zu`\n",
+                  name.c_str(), "0", "0", "0", "644", size);
+    return std::string(buf, 60);
+}
+
+// Appends a 32-bit little-endian value.
+static void putLE32(std::string& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+}
+
+// Builds a BSD archive with a __.SYMDEF index and one ELF member with a long name.
+static std::string buildBsdArchive(const std::string& elf, const std::string& memberName,
+                                   const std::string& symbol) {
+    std::string out = "!<arch>\n";
+
+    // Symbol index: one ranlib entry pointing at the member header that follows
+    std::string symdefName = "__.SYMDEF SORTED";
+    symdefName.resize(20, '\0');
+    std::string strtab = symbol + '\0';
+    strtab.resize((strtab.size() + 3) & ~size_t(3), '\0');
+    size_t symdefSize = symdefName.size() + 4 + 8 + 4 + strtab.size();
+    uint32_t memberHeaderOffset = static_cast<uint32_t>(out.size() + 60 + symdefSize);
+
+    out += arHeader("#1/" + std::to_string(symdefName.size()), symdefSize);
+    out += symdefName;
+    putLE32(out, 8);
+    putLE32(out, 0);
+    putLE32(out, memberHeaderOffset);
+    putLE32(out, static_cast<uint32_t>(strtab.size()));
+    out += strtab;
+    if (out.size() & 1) out.push_back('\n');
+
+    assert(out.size() == memberHeaderOffset);
+    out += arHeader("#1/" + std::to_string(memberName.size()), memberName.size() + elf.size());
+    out += memberName;
+    out += elf;
+    if (out.size() & 1) out.push_back('\n');
+    return out;
+}
+
+int main(int argc, char** argv) {
+    assert(argc > 2);
+
+    // GNU archive produced by the toolchain
+    minielf::MiniArchive gnu(argv[1]);
+    assert(gnu.isValid());
+    const auto& members = gnu.getMembers();
+    assert(members.size() == 2);
+
+    bool hasLongName = false;
+    for (const auto& m : members) {
+        assert(m.name.find('/') == std::string::npos);
+        hasLongName = hasLongName || m.name.size() > 15;
+    }
+    assert(hasLongName);
+
+    gnu.loadMembers(4);
+    for (size_t i = 0; i < members.size(); ++i) {
+        const auto* obj = gnu.getMemberELF(i);
+        assert(obj && obj->isValid());
+        assert(obj->isRelocatable());
+    }
+    assert(gnu.getMemberELF(members.size()) == nullptr);
+
+    assert(!gnu.getSymbolIndex().empty());
+    const auto* helperMember = gnu.findMemberForSymbol("minielf_archive_helper");
+    assert(helperMember && helperMember->name.size() > 15);
+    const auto* helperObj = gnu.getMemberELF(helperMember->index);
+    assert(helperObj->getSymbolByName("minielf_archive_helper"));
+    const auto* mainMember = gnu.findMemberForSymbol("main");
+    assert(mainMember && mainMember != helperMember);
+    assert(gnu.findMemberForSymbol("no_such_symbol") == nullptr);
+
+    // BSD archive assembled around a linked ELF file
+    std::ifstream in(argv[2], std::ios::binary);
+    std::string elf((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    assert(!elf.empty());
+    const std::string bsdPath = "test_archive_bsd.a";
+    const std::string memberName = "a_rather_long_member_name.elf";
+    {
+        std::ofstream out(bsdPath, std::ios::binary);
+        out << buildBsdArchive(elf, memberName, "main");
+    }
+    minielf::MiniArchive bsd(bsdPath);
+    assert(bsd.isValid());
+    assert(bsd.getMembers().size() == 1);
+    assert(bsd.getMembers()[0].name == memberName);
+    assert(bsd.getMembers()[0].size == elf.size());
+    const auto* bsdMain = bsd.findMemberForSymbol("main");
+    assert(bsdMain && bsdMain->index == 0);
+    const auto* bsdObj = bsd.getMemberELF(0);
+    assert(bsdObj->isValid() && bsdObj->getSymbolByName("main"));
+    assert(bsdObj->getFileSize() == elf.size());
+    std::remove(bsdPath.c_str());
+
+    // Non-archive input
+    minielf::MiniArchive bad(argv[2]);
+    assert(!bad.isValid());
+    assert(!bad.getLastError().empty());
+
+    std::cout << "All MiniArchive tests passed.\n";
+    return 0;
+}
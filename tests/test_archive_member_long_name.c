@@ -0,0 +1 @@
+int minielf_archive_helper(int x) { return x * 7; }
@@ -0,0 +1,247 @@
+#include "minielf/DebugInfoClient.hpp"
+#include <arpa/inet.h>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <netinet/in.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * @file test_debuginfo.cpp
+ * @brief Unit tests for the build ID lookup client.
+ *
+ * The tests ensure that:
+ *   - Files are fetched over HTTP from a loopback server and served from the cache afterwards.
+ *   - Concurrent lookups of one build ID trigger a single fetch.
+ *   - Misses are remembered for the negative cache TTL; network errors are not.
+ *   - Invalid build IDs never reach the fetcher, and custom fetchers plug in.
+ *   - A throwing fetcher yields an error result and does not block later lookups.
+ */
+
+// Minimal debuginfod stand-in on 127.0.0.1, answering one request per connection.
+class LoopbackServer {
+public:
+    explicit LoopbackServer(std::map<std::string, std::string> files, int delayMs = 0)
+        : _files(std::move(files)), _delayMs(delayMs) {
+        _fd = socket(AF_INET, SOCK_STREAM, 0);
+        assert(_fd >= 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        assert(bind(_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+        assert(listen(_fd, 64) == 0);
+        socklen_t len = sizeof(addr);
+        getsockname(_fd, reinterpret_cast<sockaddr*>(&addr), &len);
+        _port = ntohs(addr.sin_port);
+        _thread = std::thread([this] { serve(); });
+    }
+
+    ~LoopbackServer() {
+        shutdown(_fd, SHUT_RDWR);
+        _thread.join();
+        close(_fd);
+    }
+
+    std::string url() const { return "http://127.0.0.1:" + std::to_string(_port); }
+    int requests() const { return _requests; }
+
+private:
+    void serve() {
+        for (;;) {
+            int client = accept(_fd, nullptr, nullptr);
+            if (client < 0) return;
+            std::string request;
+            char buffer[1024];
+            while (request.find("\r\n\r\n") == std::string::npos) {
+                ssize_t n = recv(client, buffer, sizeof(buffer), 0);
+                if (n <= 0) break;
+                request.append(buffer, static_cast<size_t>(n));
+            }
+            ++_requests;
+            std::this_thread::sleep_for(std::chrono::milliseconds(_delayMs));
+
+            std::istringstream line(request);
+            std::string method, path;
+            line >> method >> path;
+            auto it = _files.find(path);
+            std::string response = it == _files.end()
+                ? "HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\n\r\n"
+                : "HTTP/1.0 200 OK\r\nContent-Length: " + std::to_string(it->second.size()) + "\r\n\r\n" + it->second;
+            send(client, response.data(), response.size(), MSG_NOSIGNAL);
+            close(client);
+        }
+    }
+
+    std::map<std::string, std::string> _files;
+    int _delayMs;
+    int _fd = -1;
+    int _port = 0;
+    std::atomic<int> _requests{0};
+    std::thread _thread;
+};
+
+// Fetcher writing a fixed body for every build ID, counting calls.
+class CountingFetcher : public minielf::DebugInfoFetcher {
+public:
+    minielf::FetchStatus fetch(const std::string& buildId, minielf::DebugArtifact,
+                               const std::string& destination, std::string&) override {
+        ++calls;
+        std::ofstream(destination) << "debug:" << buildId;
+        return minielf::FetchStatus::Found;
+    }
+    std::atomic<int> calls{0};
+};
+
+// Fetcher throwing on its first call, after giving other lookups time to join.
+class ThrowingFetcher : public CountingFetcher {
+public:
+    minielf::FetchStatus fetch(const std::string& buildId, minielf::DebugArtifact artifact,
+                               const std::string& destination, std::string& error) override {
+        if (!thrown.exchange(true)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            throw std::runtime_error("connection reset");
+        }
+        return CountingFetcher::fetch(buildId, artifact, destination, error);
+    }
+    std::atomic<bool> thrown{false};
+};
+
+static std::string readFile(const std::string& path) {
+    std::ifstream in(path);
+    return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+static std::string makeCacheDir() {
+    char dir[] = "/tmp/minielf-debuginfo-XXXXXX";
+    assert(mkdtemp(dir));
+    return dir;
+}
+
+// Checks fetching, caching and coalescing against the loopback server.
+static void testHttpFetch(const std::string& cacheDir) {
+    const std::string body(200000, 'x');
+    LoopbackServer server({{"/buildid/0123abcd/debuginfo", body},
+                           {"/buildid/0123abcd/executable", "exe"},
+                           {"/buildid/beef/debuginfo", "shared"}}, 50);
+    auto fetcher = std::make_shared<minielf::HttpFetcher>(std::vector<std::string>{server.url()}, 5);
+    minielf::DebugInfoClient client(cacheDir + "/nested/cache", fetcher);
+
+    auto found = client.find("0123ABCD");
+    assert(found.status == minielf::FetchStatus::Found);
+    assert(found.path == cacheDir + "/nested/cache/0123abcd/debuginfo");
+    assert(readFile(found.path) == body);
+    assert(server.requests() == 1);
+
+    // Served from the cache, also by a second client sharing the directory
+    assert(client.find(std::vector<uint8_t>{0x01, 0x23, 0xab, 0xcd}).path == found.path);
+    minielf::DebugInfoClient other(cacheDir + "/nested/cache", fetcher);
+    assert(other.find("0123abcd").status == minielf::FetchStatus::Found);
+    assert(server.requests() == 1 && other.getFetchCount() == 0);
+
+    auto exe = client.find("0123abcd", minielf::DebugArtifact::Executable);
+    assert(exe.status == minielf::FetchStatus::Found && readFile(exe.path) == "exe");
+    assert(server.requests() == 2);
+
+    // Many threads asking for the same build ID share one fetch
+    std::vector<std::thread> threads;
+    std::vector<minielf::FetchResult> results(8);
+    for (size_t i = 0; i < results.size(); ++i)
+        threads.emplace_back([&, i] { results[i] = client.find("beef"); });
+    for (auto& t : threads) t.join();
+    for (const auto& r : results) {
+        assert(r.status == minielf::FetchStatus::Found);
+        assert(readFile(r.path) == "shared");
+    }
+    assert(server.requests() == 3);
+    assert(client.getFetchCount() == 3);
+
+    // Misses are remembered; with a zero TTL they are asked again
+    assert(client.find("dead").status == minielf::FetchStatus::NotFound);
+    assert(client.find("dead").status == minielf::FetchStatus::NotFound);
+    assert(server.requests() == 4);
+    client.setNegativeCacheTtl(0);
+    assert(client.find("dead").status == minielf::FetchStatus::NotFound);
+    assert(server.requests() == 5);
+}
+
+// Checks that failures are reported and not cached.
+static void testFailures(const std::string& cacheDir) {
+    // A port nobody listens on: bind, then close before connecting
+    std::string url;
+    {
+        LoopbackServer closed({});
+        url = closed.url();
+    }
+    auto fetcher = std::make_shared<minielf::HttpFetcher>(std::vector<std::string>{url}, 1);
+    minielf::DebugInfoClient client(cacheDir, fetcher);
+    auto failed = client.find("cafe");
+    assert(failed.status == minielf::FetchStatus::Error && !failed.error.empty());
+    struct stat st{};
+    assert(stat((cacheDir + "/cafe/.debuginfo.miss").c_str(), &st) != 0);
+    assert(client.find("cafe").status == minielf::FetchStatus::Error);
+    assert(client.getFetchCount() == 2);
+
+    for (const char* invalid : {"", "abc", "../x", "zz"}) {
+        auto r = client.find(std::string(invalid));
+        assert(r.status == minielf::FetchStatus::Error);
+    }
+    assert(client.getFetchCount() == 2);
+
+    minielf::DebugInfoClient https(cacheDir, std::make_shared<minielf::HttpFetcher>(
+        std::vector<std::string>{"https://debuginfod.example.com"}));
+    assert(https.find("cafe").status == minielf::FetchStatus::Error);
+
+    // Without a fetcher the client only reads the cache
+    minielf::DebugInfoClient offline(cacheDir, nullptr);
+    assert(offline.find("cafe").status == minielf::FetchStatus::NotFound);
+}
+
+// Checks a custom fetcher.
+static void testCustomFetcher(const std::string& cacheDir) {
+    auto fetcher = std::make_shared<CountingFetcher>();
+    minielf::DebugInfoClient client(cacheDir, fetcher);
+    auto r = client.find("a1b2");
+    assert(r.status == minielf::FetchStatus::Found && readFile(r.path) == "debug:a1b2");
+    client.find("A1B2");
+    assert(fetcher->calls == 1);
+}
+
+// Checks that a fetcher exception reaches every caller as an error and is not cached.
+static void testThrowingFetcher(const std::string& cacheDir) {
+    auto fetcher = std::make_shared<ThrowingFetcher>();
+    minielf::DebugInfoClient client(cacheDir, fetcher);
+    minielf::FetchResult joined;
+    std::thread waiter([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        joined = client.find("beef");
+    });
+    auto r = client.find("beef");
+    waiter.join();
+    assert(r.status == minielf::FetchStatus::Error && r.error.find("connection reset") != std::string::npos);
+    assert(joined.status != minielf::FetchStatus::NotFound);
+    r = client.find("beef");
+    assert(r.status == minielf::FetchStatus::Found && readFile(r.path) == "debug:beef");
+}
+
+int main() {
+    const std::string cacheDir = makeCacheDir();
+    testHttpFetch(cacheDir + "/http");
+    testFailures(cacheDir + "/failures");
+    testCustomFetcher(cacheDir + "/custom");
+    testThrowingFetcher(cacheDir + "/throwing");
+    std::system(("rm -rf '" + cacheDir + "'").c_str());
+
+    std::cout << "All debug info client tests passed.\n";
+    return 0;
+}
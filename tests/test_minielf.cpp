@@ -1,6 +1,29 @@
 #include "minielf/MiniELF.hpp"
+#include "minielf/SymbolExporter.hpp"
+#include "minielf/MappedView.hpp"
+#include "minielf/ByteSource.hpp"
+#include "minielf/ProcessImage.hpp"
+#include "minielf/ElfDiff.hpp"
+#include "minielf/SizeReport.hpp"
+#include "ElfWriter.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <future>
+#include <iterator>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <sstream>
+#include <csignal>
+#include <cstdlib>
+#include <new>
+#include <string_view>
+#include <sys/wait.h>
+#include <unistd.h>
 
 /**
  * @file test_minielf.cpp
@@ -16,12 +39,1108 @@
  *   - The getNearestSymbol method finds the closest symbol at or before a given address.
  *   - The getSectionByAddress method resolves the section containing a symbol's address.
  *   - ELF metadata (entry point, version, machine, type) is correct and accessible.
+ *   - Relocatable objects (ET_REL) resolve symbols by (section, offset).
+ *   - Objects using extended section numbering (>= 0xff00 sections) parse in linear time.
+ *   - Size-ordered queries return the largest symbols and size ranges, optionally by type.
+ *   - The name index keeps every symbol sharing a name.
+ *   - The GNU build ID is read and symbols export to perf map, Breakpad and list formats.
+ *   - Overlay symbols (in-memory, perf maps, symbol lists) merge into the address index.
+ *   - Mapped views resolve runtime addresses of one shared file at different load biases.
+ *   - File, mmap, memory and custom byte sources all parse to the same result.
+ *   - Images read from process memory yield the dynamic symbols of the files on disk.
+ *   - The vDSO is located through the auxiliary vector and parsed once per kernel.
+ *   - Requested sections are hashed (XXH64) identically through every byte source.
+ *   - Two builds diff into added, removed, resized and modified symbols and sections.
+ *   - File and VM bytes are attributed once per level to segments, sections and symbols.
+ *   - Address window queries return exactly the symbols and sections intersecting [lo, hi).
+ *   - Indexes warmed in the background give the same answers, also through the fallback scans.
+ *   - Each lookup index is built only when used and can be released and rebuilt.
+ *   - Name lookups through std::string_view and const char* do not allocate.
+ *   - Copies share one parsed image; overlays copy it first and moves leave an empty handle.
  *
  * Usage:
  *   Compile and run this test to verify the core MiniELF functionality.
+ *   The optional first argument is the path to a relocatable object (.o).
  */
 
-int main() {
+// Counts heap allocations so tests can check that a path does not allocate.
+static std::atomic<size_t> g_allocations{0};
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+// Checks section-relative symbol lookups on a relocatable object.
+static void testRelocatable(const char* path) {
+    minielf::MiniELF obj(path);
+    assert(obj.isValid());
+    assert(obj.isRelocatable());
+
+    const auto* text = obj.getSectionByName(".text");
+    assert(text && text->address == 0);
+    assert(obj.getSections()[text->index].name == ".text");
+
+    const auto* main_sym = obj.getSymbolByName("main");
+    assert(main_sym && main_sym->sectionIndex == text->index);
+    assert(main_sym->size > 0);
+
+    // Symbol values are section offsets, so address lookups are not meaningful
+    assert(obj.getSymbolByAddress(main_sym->address) == nullptr);
+    assert(obj.getSectionByAddress(0) == nullptr);
+
+    auto in_text = obj.getSymbolsInSection(text->index);
+    assert(!in_text.empty());
+    bool listed = false;
+    for (const auto* sym : in_text) {
+        assert(sym->sectionIndex == text->index);
+        listed = listed || sym == main_sym;
+    }
+    assert(listed);
+
+    assert(obj.getSymbolBySectionOffset(text->index, main_sym->address) == main_sym);
+    assert(obj.getSymbolBySectionOffset(text->index, main_sym->address + main_sym->size - 1) == main_sym);
+    assert(obj.getNearestSymbolInSection(text->index, main_sym->address + 1) == main_sym);
+    assert(obj.getSymbolsInSection(static_cast<uint32_t>(obj.getSections().size())).empty());
+}
+
+// Writes an object with `count` function sections and one symbol per section.
+static void writeManySections(const std::string& path, uint32_t count) {
+    minielf_test::ElfWriter writer;
+    for (uint32_t i = 0; i < count; ++i) {
+        std::string name = ".text.f" + std::to_string(i);
+        uint32_t idx = writer.addSection({name, 1, 0x6 /* SHF_ALLOC|SHF_EXECINSTR */, 0, "\xc3"});
+        writer.addSymbol({"f" + std::to_string(i), 0, 1, 0x12, idx});
+    }
+    writer.addSymbol({"abs_value", 42, 0, 0x10, 0xfffffff1u /* SHN_ABS */});
+    assert(writer.write(path));
+}
+
+// File source counting the reads the parser issues and the bytes they return.
+class CountingFileSource : public minielf::FileByteSource {
+public:
+    explicit CountingFileSource(const std::string& path) : FileByteSource(path) {}
+    size_t readAt(uint64_t offset, void* buffer, size_t size) const override {
+        size_t n = FileByteSource::readAt(offset, buffer, size);
+        ++reads;
+        bytes += n;
+        return n;
+    }
+    mutable uint64_t reads = 0;
+    mutable uint64_t bytes = 0;
+};
+
+// Parses the file and returns the elapsed wall time in seconds (best of 3).
+static double timeParse(const std::string& path) {
+    double best = 1e9;
+    for (int run = 0; run < 3; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        minielf::MiniELF obj(path);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        assert(obj.isValid());
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+// Checks extended numbering (e_shnum == 0, SHN_XINDEX, SHT_SYMTAB_SHNDX).
+static void testExtendedNumbering() {
+    const uint32_t count = 200000;
+    const std::string big = "test_extended_numbering_200k.o";
+    const std::string half = "test_extended_numbering_100k.o";
+    writeManySections(big, count);
+    writeManySections(half, count / 2);
+
+    minielf::MiniELF obj(big);
+    assert(obj.isValid());
+    assert(obj.getRawHeader().e_shnum == 0);
+    assert(obj.getRawHeader().e_shstrndx == 0xffff);
+    // null + user sections + .shstrtab + .symtab + .strtab + .symtab_shndx
+    assert(obj.getSectionHeaders().size() == count + 5);
+    assert(obj.getSections().size() == count + 5);
+    assert(obj.getSectionByName(".shstrtab"));
+
+    const uint32_t last = count; // section index of ".text.f<count-1>"
+    assert(obj.getSections()[last].name == ".text.f" + std::to_string(count - 1));
+    const auto* sym = obj.getSymbolByName("f" + std::to_string(count - 1));
+    assert(sym && sym->sectionIndex == last);
+    assert(obj.getSymbolBySectionOffset(last, 0) == sym);
+    const auto* low = obj.getSymbolByName("f7");
+    assert(low && low->sectionIndex == 8);
+
+    // Reserved indices never alias a real section
+    const auto* abs = obj.getSymbolByName("abs_value");
+    assert(abs && abs->sectionIndex == 0xfffffff1u);
+    assert(obj.getSymbolsInSection(0xfff1).size() == 1);
+
+    // Parsing must stay linear in the number of sections: count the reads, time for information only
+    CountingFileSource halfSource(half), fullSource(big);
+    assert(minielf::MiniELF(halfSource, half).isValid() && minielf::MiniELF(fullSource, big).isValid());
+    assert(fullSource.reads == halfSource.reads); // bulk reads, not one per section
+    assert(fullSource.bytes <= fullSource.size() && halfSource.bytes <= halfSource.size()); // each byte at most once
+    double tHalf = timeParse(half);
+    double tFull = timeParse(big);
+    std::cout << "[Extended numbering] 100K sections: " << tHalf << " s, 200K sections: "
+              << tFull << " s\n";
+
+    std::remove(big.c_str());
+    std::remove(half.c_str());
+}
+
+// Checks that a program header count beyond the image is a parse error, not an allocation.
+static void testMalformedProgramHeaderCount() {
+    minielf_test::ElfWriter writer;
+    writer.addSection({".text", 1, 0x6, 0, std::string(16, '\x90')});
+    std::string bytes = writer.build();
+    minielf::Elf64_Ehdr ehdr;
+    memcpy(&ehdr, bytes.data(), sizeof(ehdr));
+    ehdr.e_phoff = sizeof(ehdr);
+    ehdr.e_phnum = 0xffff; // PN_XNUM: the real count is in shdr0.sh_info
+    memcpy(&bytes[0], &ehdr, sizeof(ehdr));
+    minielf::Elf64_Shdr shdr0;
+    memcpy(&shdr0, bytes.data() + ehdr.e_shoff, sizeof(shdr0));
+    shdr0.sh_info = 0x40000000;
+    memcpy(&bytes[ehdr.e_shoff], &shdr0, sizeof(shdr0));
+
+    minielf::MiniELF obj(bytes.data(), bytes.size(), "phnum.o");
+    assert(!obj.isValid());
+    assert(obj.getFailureStage() == minielf::MiniELF::ParseStage::ProgramHeaders);
+    assert(obj.getProgramHeaders().empty());
+
+    // A count that fits is still read
+    shdr0.sh_info = 1;
+    memcpy(&bytes[ehdr.e_shoff], &shdr0, sizeof(shdr0));
+    minielf::MiniELF fits(bytes.data(), bytes.size(), "phnum1.o");
+    assert(fits.isValid() && fits.getProgramHeaders().size() == 1);
+}
+
+// Checks top-N and size-range queries on the size-ordered index.
+static void testSizeIndex() {
+    minielf_test::ElfWriter writer;
+    uint32_t text = writer.addSection({".text", 1, 0x6, 0, std::string(4096, '\x90')});
+    uint32_t data = writer.addSection({".data", 1, 0x3, 0, std::string(4096, '\0')});
+    writer.addSymbol({"small_fn", 0, 16, 0x12, text});
+    writer.addSymbol({"big_fn", 16, 2000, 0x12, text});
+    writer.addSymbol({"mid_fn", 2016, 500, 0x12, text});
+    writer.addSymbol({"big_table", 0, 3000, 0x11 /* STB_GLOBAL|STT_OBJECT */, data});
+    writer.addSymbol({"tiny_var", 3000, 8, 0x11, data});
+    std::string bytes = writer.build();
+    minielf::MiniELF obj(bytes.data(), bytes.size(), "size_index.o");
+    assert(obj.isValid());
+
+    auto top = obj.getLargestSymbols(2);
+    assert(top.size() == 2);
+    assert(top[0]->name == "big_table" && top[1]->name == "big_fn");
+    assert(obj.getLargestSymbols(1000).size() == obj.getSymbols().size());
+
+    auto topFn = obj.getLargestSymbols(10, minielf::SymbolType::FUNC);
+    assert(topFn.size() == 3);
+    assert(topFn[0]->name == "big_fn" && topFn[1]->name == "mid_fn" && topFn[2]->name == "small_fn");
+
+    auto mid = obj.getSymbolsBySize(16, 2000);
+    assert(mid.size() == 3);
+    for (const auto* sym : mid) assert(sym->size >= 16 && sym->size <= 2000);
+
+    auto bigObjects = obj.getSymbolsBySize(1024, UINT64_MAX, minielf::SymbolType::OBJECT);
+    assert(bigObjects.size() == 1 && bigObjects[0]->name == "big_table");
+    assert(obj.getSymbolsBySize(5000, UINT64_MAX).empty());
+    assert(obj.getLargestSymbols(5, minielf::SymbolType::TLS).empty());
+}
+
+// Checks that duplicate names (file-local statics) are all kept by the name index.
+static void testDuplicateNames() {
+    minielf_test::ElfWriter writer;
+    uint32_t a = writer.addSection({".text.a", 1, 0x6, 0, std::string(64, '\x90')});
+    uint32_t b = writer.addSection({".text.b", 1, 0x6, 0, std::string(64, '\x90')});
+    writer.addSymbol({"init", 0, 8, 0x02 /* STB_LOCAL|STT_FUNC */, a});
+    writer.addSymbol({"init", 0, 16, 0x02, b});
+    writer.addSymbol({"helper", 8, 8, 0x02, a});
+    writer.addSymbol({"init", 32, 4, 0x12 /* STB_GLOBAL|STT_FUNC */, b});
+    std::string bytes = writer.build();
+    minielf::MiniELF obj(bytes.data(), bytes.size(), "duplicates.o");
+    assert(obj.isValid());
+
+    auto inits = obj.getSymbolsByName("init");
+    assert(inits.size() == 3);
+    assert(inits[0]->sectionIndex == a && inits[0]->size == 8);
+    assert(inits[1]->sectionIndex == b && inits[1]->size == 16);
+    assert(inits[2]->sectionIndex == b && inits[2]->size == 4);
+
+    // The single-result lookup prefers the last (global) definition
+    assert(obj.getSymbolByName("init") == inits[2]);
+    assert(obj.getSymbolsByName("helper").size() == 1);
+    assert(obj.getSymbolsByName("missing").empty());
+    assert(obj.getSymbolsByName("").empty());
+}
+
+// Checks that name lookups with views of a larger buffer and C strings do not allocate.
+static void testStringViewLookups() {
+    minielf_test::ElfWriter writer;
+    uint32_t text = writer.addSection({".text", 1, 0x6, 0, std::string(64, '\x90')});
+    writer.addSymbol({"init", 0, 8, 0x12 /* STB_GLOBAL|STT_FUNC */, text});
+    writer.addSymbol({"init_late", 8, 8, 0x12, text});
+    std::string bytes = writer.build();
+    minielf::MiniELF obj(bytes.data(), bytes.size(), "views.o");
+    assert(obj.isValid());
+    assert(obj.getSymbolByName("init"));
+    assert(obj.getSectionByName(".text"));
+
+    // Names sliced out of a larger buffer, as read from a file or a command line
+    const char buffer[] = "init_late.text.data";
+    const std::string_view late(buffer, 9), init(buffer, 4), textName(buffer + 9, 5);
+    const char* cstr = "init";
+
+    const size_t before = g_allocations.load();
+    const minielf::Symbol* a = obj.getSymbolByName(init);
+    const minielf::Symbol* b = obj.getSymbolByName(late);
+    const minielf::Symbol* c = obj.getSymbolByName(cstr);
+    const size_t n = obj.getSymbolsByName(init).size();
+    const minielf::Section* sec = obj.getSectionByName(textName);
+    const minielf::Section* missing = obj.getSectionByName(std::string_view(buffer + 14, 5));
+    const size_t allocations = g_allocations.load() - before;
+
+    assert(allocations == 0);
+    assert(a && a->name == "init" && a == c && n == 1);
+    assert(b && b->name == "init_late" && b->size == 8);
+    assert(sec && sec->name == ".text");
+    assert(!missing);
+    assert(!obj.getSymbolByName(std::string_view(buffer, 3)));
+    assert(!obj.getSymbolByName(std::string_view()));
+}
+
+// Checks build ID parsing and the perf map, Breakpad and symbol list exporters.
+static void testExporters() {
+    minielf_test::ElfWriter writer(3 /* ET_DYN */);
+    std::string note("\x04\0\0\0\x14\0\0\0\x03\0\0\0GNU\0", 16);
+    for (int i = 0; i < 20; ++i) note.push_back(static_cast<char>(i));
+    writer.addSection({".note.gnu.build-id", 7 /* SHT_NOTE */, 0x2, 0x200, note});
+    uint32_t text = writer.addSection({".text", 1, 0x6, 0x1000, std::string(0x100, '\x90')});
+    uint32_t data = writer.addSection({".data", 1, 0x3, 0x2000, std::string(0x10, '\0')});
+    writer.addSymbol({"beta", 0x1040, 0x10, 0x12, text});
+    writer.addSymbol({"alpha", 0x1000, 0x20, 0x12, text});
+    writer.addSymbol({"beta_alias", 0x1040, 0x10, 0x22 /* STB_WEAK|STT_FUNC */, text});
+    writer.addSymbol({"label", 0x1080, 0, 0x12, text});
+    writer.addSymbol({"table", 0x2000, 8, 0x11 /* STB_GLOBAL|STT_OBJECT */, data});
+    writer.addSymbol({"external", 0, 0, 0x12, 0});
+    writer.addSymbol({"file.c", 0, 0, 0x04 /* STT_FILE */, 0xfffffff1 /* SHN_ABS */});
+    std::string bytes = writer.build();
+    minielf::MiniELF elf(bytes.data(), bytes.size(), "/tmp/libexport.so");
+    assert(elf.isValid());
+    assert(elf.getBuildId().size() == 20);
+    assert(elf.getBuildId()[0] == 0 && elf.getBuildId()[19] == 19);
+    assert(elf.getSymbolsSortedByAddress().size() == elf.getSymbols().size());
+
+    minielf::SymbolExporter exporter(elf);
+    std::ostringstream perf;
+    assert(exporter.write(perf, minielf::ExportFormat::PerfMap, 0x7f0000000000) == 3);
+    assert(perf.str() == "7f0000001000 20 alpha\n"
+                         "7f0000001040 10 beta\n"
+                         "7f0000001040 10 beta_alias\n");
+
+    std::ostringstream breakpad;
+    assert(exporter.write(breakpad, minielf::ExportFormat::Breakpad) == 3);
+    assert(breakpad.str() == "MODULE Linux x86_64 030201000504070608090A0B0C0D0E0F0 libexport.so\n"
+                             "INFO CODE_ID 000102030405060708090a0b0c0d0e0f10111213\n"
+                             "PUBLIC 1000 0 alpha\n"
+                             "PUBLIC 1040 0 beta\n"
+                             "PUBLIC 1080 0 label\n");
+
+    std::ostringstream list;
+    assert(exporter.write(list, minielf::ExportFormat::SymbolList) == 5);
+    assert(list.str().find("0000000000002000 0000000000000008 OBJECT table\n") != std::string::npos);
+    assert(list.str().find("external") == std::string::npos);
+    assert(list.str().find("file.c") == std::string::npos);
+
+    assert(minielf::SymbolExporter::breakpadModuleId({}) == std::string(33, '0'));
+
+    // Without a build ID, Breakpad export is refused rather than writing a colliding module ID
+    minielf_test::ElfWriter anonymous(3);
+    uint32_t anonymousText = anonymous.addSection({".text", 1, 0x6, 0x1000, std::string(0x10, '\x90')});
+    anonymous.addSymbol({"alpha", 0x1000, 0x10, 0x12, anonymousText});
+    std::string anonymousBytes = anonymous.build();
+    minielf::MiniELF anonymousElf(anonymousBytes.data(), anonymousBytes.size(), "anonymous.so");
+    assert(anonymousElf.isValid() && anonymousElf.getBuildId().empty());
+    minielf::SymbolExporter anonymousExporter(anonymousElf);
+    std::ostringstream refused;
+    assert(!anonymousExporter.canWrite(minielf::ExportFormat::Breakpad));
+    assert(anonymousExporter.write(refused, minielf::ExportFormat::Breakpad) == 0 && refused.str().empty());
+    assert(!anonymousExporter.writeFile("anonymous.sym", minielf::ExportFormat::Breakpad));
+    assert(anonymousExporter.canWrite(minielf::ExportFormat::PerfMap));
+
+    // Large outputs cross the writer's buffer boundary
+    minielf_test::ElfWriter many(3);
+    uint32_t bigText = many.addSection({".text", 1, 0x6, 0x1000, std::string(16, '\x90')});
+    for (int i = 0; i < 20000; ++i) many.addSymbol({"function_" + std::to_string(i), 0x1000 + 16u * i, 16, 0x12, bigText});
+    std::string manyBytes = many.build();
+    minielf::MiniELF manyElf(manyBytes.data(), manyBytes.size(), "many.so");
+    std::ostringstream manyOut;
+    assert(minielf::SymbolExporter(manyElf).write(manyOut, minielf::ExportFormat::PerfMap) == 20000);
+    const std::string manyText = manyOut.str();
+    assert(manyText.rfind("4f1f0 10 function_19999\n") == manyText.size() - 24);
+    assert(std::count(manyText.begin(), manyText.end(), '\n') == 20000);
+}
+
+// Checks that overlay symbols merge into the address index with priorities.
+static void testOverlaySymbols() {
+    minielf_test::ElfWriter writer(3 /* ET_DYN */);
+    uint32_t text = writer.addSection({".text", 1, 0x6, 0x1000, std::string(0x100, '\x90')});
+    writer.addSymbol({"elf_func", 0x1000, 0x100, 0x12, text});
+    std::string bytes = writer.build();
+    minielf::MiniELF elf(bytes.data(), bytes.size(), "overlay.so");
+    assert(elf.isValid());
+    assert(elf.getNearestSymbol(0x5008)->name == "elf_func");
+
+    using minielf::SymbolType;
+    elf.addOverlaySymbols({{"jit_b", 0x6000, 0x10, SymbolType::FUNC}, {"jit_a", 0x5000, 0x10, SymbolType::FUNC}});
+    assert(elf.getOverlaySymbolCount() == 2);
+    assert(elf.getNearestSymbol(0x5008)->name == "jit_a");
+    assert(elf.getNearestSymbol(0x6fff)->name == "jit_b");
+    assert(elf.getNearestSymbol(0x1010)->name == "elf_func");
+    assert(elf.getSymbolsByName("jit_a").empty()); // address index only
+
+    // Same address: higher priority wins, then the later registration
+    elf.addOverlaySymbols({{"override", 0x1000, 0x100, SymbolType::FUNC}}, 2);
+    elf.addOverlaySymbols({{"low", 0x1000, 0x100, SymbolType::FUNC}}, 1);
+    assert(elf.getNearestSymbol(0x1010)->name == "override");
+    elf.addOverlaySymbols({{"newer", 0x1000, 0x100, SymbolType::FUNC}}, 2);
+    assert(elf.getNearestSymbol(0x1010)->name == "newer");
+    auto sorted = elf.getSymbolsSortedByAddress();
+    for (size_t i = 1; i < sorted.size(); ++i) assert(sorted[i - 1]->address <= sorted[i]->address);
+
+    // Perf map ingestion is incremental; partial lines wait for their newline
+    const std::string map = "test_overlay_perf.map";
+    {
+        std::ofstream out(map, std::ios::trunc);
+        out << "7000 20 LazyCompile:~main app.js:1\n0x7100 8 stub\nnot a line\n7200 1";
+    }
+    minielf::MiniELF jit(bytes.data(), bytes.size(), "overlay.so");
+    assert(jit.loadPerfMap(map));
+    assert(jit.getOverlaySymbolCount() == 2);
+    assert(jit.getNearestSymbol(0x7010)->name == "LazyCompile:~main app.js:1");
+    {
+        std::ofstream out(map, std::ios::app);
+        out << "0 tail\n7300 10 later\n";
+    }
+    assert(jit.loadPerfMap(map));
+    assert(jit.getOverlaySymbolCount() == 4);
+    assert(jit.getNearestSymbol(0x7205)->name == "tail");
+    assert(jit.getNearestSymbol(0x7305)->name == "later");
+    assert(jit.loadPerfMap(map) && jit.getOverlaySymbolCount() == 4);
+    assert(!jit.loadPerfMap("missing_overlay.map"));
+    std::remove(map.c_str());
+
+    // Symbol lists written by the exporter load back with their types
+    const std::string list = "test_overlay_symbols.txt";
+    assert(minielf::SymbolExporter(elf).writeFile(list, minielf::ExportFormat::SymbolList));
+    minielf::MiniELF copy(bytes.data(), bytes.size(), "overlay.so");
+    assert(copy.loadSymbolList(list));
+    assert(copy.getOverlaySymbolCount() == 6);
+    assert(copy.getNearestSymbol(0x5008)->name == "jit_a");
+    assert(copy.getNearestSymbol(0x5008)->type == SymbolType::FUNC);
+    std::remove(list.c_str());
+}
+
+// Checks biased lookups through views sharing one parsed file.
+static void testMappedViews() {
+    minielf_test::ElfWriter writer(3 /* ET_DYN */);
+    uint32_t text = writer.addSection({".text", 1, 0x6, 0x1000, std::string(0x100, '\x90')});
+    writer.addSymbol({"first", 0x1000, 0x80, 0x12, text});
+    writer.addSymbol({"second", 0x1080, 0x80, 0x12, text});
+    std::string bytes = writer.build();
+    minielf::MiniELF lib(bytes.data(), bytes.size(), "libshared.so");
+    assert(lib.isValid());
+
+    minielf::MappedView a(lib, 0x7f0000000000);
+    minielf::MappedView b = minielf::MappedView::fromMapping(lib, 0x555555550000);
+    static_assert(sizeof(minielf::MappedView) <= 4 * sizeof(uint64_t), "views stay small");
+    assert(b.getBias() == 0x555555550000);
+    assert(&a.getELF() == &b.getELF());
+
+    assert(a.getNearestSymbol(0x7f0000001090)->name == "second");
+    assert(b.getNearestSymbol(0x555555551010)->name == "first");
+    assert(a.getSymbolByAddress(0x7f0000001010)->name == "first");
+    assert(a.getSymbolByAddress(0x7f0000001090)->name == "second");
+    assert(lib.getSymbolByAddress(0x1090)->name == "second"); // inside the later of two adjacent symbols
+    assert(!a.getNearestSymbol(0x1010)); // below the bias
+    assert(a.getSectionByAddress(0x7f0000001010)->name == ".text");
+    assert(*a.getSymbolAddress("second") == 0x7f0000001080);
+    assert(!b.getSymbolAddress("missing"));
+    assert(a.getRuntimeAddress(*lib.getSymbolByName("first")) == 0x7f0000001000);
+    assert(*b.toFileAddress(b.toRuntimeAddress(0x1034)) == 0x1034);
+    assert(!b.toFileAddress(b.toRuntimeAddress(0x1234))); // past the loaded extent
+
+    assert(a.contains(0x7f0000001000) && a.contains(0x7f00000010ff));
+    assert(!a.contains(0x7f0000001100) && !a.contains(0x555555551000));
+
+    // Loaded below its link address: the bias wraps around.
+    minielf::MappedView below(lib, uint64_t(0) - 0x800);
+    assert(below.contains(0x800) && !below.contains(0x1000 - 0x801));
+    assert(*below.toFileAddress(0x890) == 0x1090);
+    assert(below.getSymbolByAddress(0x890)->name == "second");
+    assert(below.getRuntimeAddress(*lib.getSymbolByName("first")) == 0x800);
+}
+
+// Byte source over an XOR-"encrypted" buffer, without views; counts reads and batches.
+class XorSource : public minielf::ByteSource {
+public:
+    XorSource(std::string data, char key) : _data(std::move(data)), _key(key) {
+        for (auto& c : _data) c ^= _key;
+    }
+    uint64_t size() const override { return _data.size(); }
+    size_t readAt(uint64_t offset, void* buffer, size_t size) const override {
+        ++reads;
+        if (offset >= _data.size()) return 0;
+        size_t n = std::min<uint64_t>(size, _data.size() - offset);
+        for (size_t i = 0; i < n; ++i) static_cast<char*>(buffer)[i] = _data[offset + i] ^ _key;
+        return n;
+    }
+    std::future<void> readBatch(minielf::ReadRequest* requests, size_t count) const override {
+        ++batches;
+        return std::async(std::launch::async, [this, requests, count]() {
+            for (size_t i = 0; i < count; ++i)
+                requests[i].bytesRead = readAt(requests[i].offset, requests[i].buffer, requests[i].size);
+        });
+    }
+    mutable int batches = 0;
+    mutable int reads = 0;
+
+private:
+    std::string _data;
+    char _key;
+};
+
+// Compares the parsed contents of two MiniELF objects.
+static bool sameContents(const minielf::MiniELF& a, const minielf::MiniELF& b) {
+    if (a.isValid() != b.isValid() || a.getFileSize() != b.getFileSize()) return false;
+    if (a.getSymbols().size() != b.getSymbols().size() || a.getSections().size() != b.getSections().size())
+        return false;
+    for (size_t i = 0; i < a.getSymbols().size(); ++i) {
+        const auto& x = a.getSymbols()[i];
+        const auto& y = b.getSymbols()[i];
+        if (x.name != y.name || x.address != y.address || x.size != y.size ||
+            x.type != y.type || x.sectionIndex != y.sectionIndex) return false;
+    }
+    for (size_t i = 0; i < a.getSections().size(); ++i)
+        if (a.getSections()[i].name != b.getSections()[i].name) return false;
+    return a.getBuildId() == b.getBuildId() && a.getProgramHeaders().size() == b.getProgramHeaders().size();
+}
+
+// Checks that every byte source implementation yields the same parse.
+static void testByteSources(const char* path) {
+    minielf::MiniELF reference(path);
+    assert(reference.isValid());
+
+    minielf::FileByteSource file(path);
+    assert(file.isOpen() && file.size() == reference.getFileSize());
+    assert(file.view(0, 16) == nullptr);
+    assert(sameContents(minielf::MiniELF(file, path), reference));
+
+    minielf::MmapByteSource mapped(path);
+    assert(mapped.isOpen() && mapped.view(0, 4) && memcmp(mapped.view(0, 4), "\x7f" "ELF", 4) == 0);
+    assert(!mapped.view(mapped.size(), 1));
+    assert(sameContents(minielf::MiniELF(mapped, path), reference));
+
+    std::ifstream in(path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    minielf::MemoryByteSource memory(bytes.data(), bytes.size());
+    char header[4];
+    assert(memory.readAt(bytes.size() - 2, header, 4) == 2);
+    assert(sameContents(minielf::MiniELF(memory, path), reference));
+
+    XorSource encrypted(bytes, 0x5a);
+    minielf::MiniELF decrypted(encrypted, "encrypted");
+    assert(sameContents(decrypted, reference));
+    assert(encrypted.batches == 1); // symbol tables fetched in one batch
+
+    assert(!minielf::FileByteSource("missing_file.elf").isOpen());
+    minielf::MemoryByteSource truncated(bytes.data(), 32);
+    minielf::MiniELF broken(truncated, "truncated");
+    assert(!broken.isValid() && broken.getFailureStage() == minielf::MiniELF::ParseStage::Header);
+}
+
+// Checks process memory reads and loaded-image parsing against this process.
+static void testProcessImage() {
+    const int pid = static_cast<int>(getpid());
+    std::vector<char> local(64 * 1024);
+    for (size_t i = 0; i < local.size(); ++i) local[i] = static_cast<char>(i * 7);
+    minielf::ProcessMemorySource memory(pid, reinterpret_cast<uintptr_t>(local.data()), local.size());
+    char probe[16];
+    if (memory.readAt(0, probe, sizeof(probe)) != sizeof(probe)) {
+        std::cout << "process_vm_readv unavailable, skipping process image tests" << std::endl;
+        return;
+    }
+    assert(memcmp(probe, local.data(), sizeof(probe)) == 0);
+
+    // More requests than fit one system call, the last one running off the end
+    std::vector<minielf::ReadRequest> requests(3000);
+    std::vector<char> out(requests.size() * 16);
+    for (size_t i = 0; i < requests.size(); ++i)
+        requests[i] = {i * 21, out.data() + i * 16, 16};
+    requests.back().offset = local.size() - 4;
+    memory.readBatch(requests.data(), requests.size()).get();
+    for (size_t i = 0; i + 1 < requests.size(); ++i) {
+        assert(requests[i].bytesRead == 16);
+        assert(memcmp(out.data() + i * 16, local.data() + i * 21, 16) == 0);
+    }
+    assert(requests.back().bytesRead == 4);
+
+    // This executable and libc, compared with their files on disk
+    char exe[4096];
+    ssize_t exeLen = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+    assert(exeLen > 0);
+    exe[exeLen] = '\0';
+    minielf::ProcessImageCache cache;
+    int checked = 0;
+    for (const auto& m : minielf::ProcessImageCache::readMappings(pid)) {
+        const bool isExe = m.path == exe;
+        const bool isLibc = m.path.find("/libc.so") != std::string::npos ||
+                            m.path.find("/libc-") != std::string::npos;
+        if ((!isExe && !isLibc) || m.perms.find('x') == std::string::npos) continue;
+
+        auto image = cache.get(pid, m);
+        assert(image && image->isValid());
+        assert(image->getSections().empty() && !image->getProgramHeaders().empty());
+        assert(cache.get(pid, m) == image);
+
+        minielf::MiniELF file(m.path);
+        const minielf::Section* dynsym = file.getSectionByName(".dynsym");
+        assert(dynsym && image->getSymbols().size() == dynsym->size / sizeof(minielf::Elf64_Sym));
+        assert(image->getBuildId() == file.getBuildId());
+        if (isLibc) {
+            const minielf::Symbol* sym = image->getSymbolByName("getpid");
+            assert(sym && sym->isFunction());
+            auto view = minielf::MappedView::fromMapping(*image, m.start, m.offset);
+            assert(view.getSymbolByAddress(view.getRuntimeAddress(*sym)) != nullptr);
+        }
+        ++checked;
+    }
+    assert(checked >= 1);
+    assert(cache.size() == static_cast<size_t>(checked));
+    cache.invalidate(pid);
+    assert(cache.size() == 0);
+
+    // Unreadable memory fails cleanly and is cached as a failure
+    auto missing = cache.get(pid, 0x10);
+    assert(missing && !missing->isValid());
+    assert(missing->getFailureStage() == minielf::MiniELF::ParseStage::Header);
+}
+
+// Checks vDSO lookup for this process and a forked child.
+static void testVdso() {
+    const int pid = static_cast<int>(getpid());
+    const uint64_t address = minielf::ProcessImageCache::findVdso(pid);
+    if (address == 0) {
+        std::cout << "no vDSO, skipping vDSO tests" << std::endl;
+        return;
+    }
+    bool mapped = false;
+    for (const auto& m : minielf::ProcessImageCache::readMappings(pid))
+        mapped |= m.path == "[vdso]" && m.start == address;
+    assert(mapped);
+
+    minielf::ProcessImageCache cache;
+    auto vdso = cache.getVdso(pid);
+    assert(vdso && vdso->isValid() && vdso->getFilePath() == "[vdso]");
+    const minielf::Symbol* sym = vdso->getSymbolByName("__vdso_clock_gettime");
+    if (!sym) sym = vdso->getSymbolByName("__kernel_clock_gettime");
+    assert(sym && sym->isFunction());
+    auto view = minielf::MappedView::fromMapping(*vdso, address);
+    const minielf::Symbol* hit = view.getSymbolByAddress(view.getRuntimeAddress(*sym));
+    assert(hit && hit->address == sym->address);
+    assert(cache.size() == 0); // vDSO images are kept apart from process images
+
+    // A forked child maps the vDSO at the same address; /proc/PID/auxv finds
+    // it and the image is shared through the per-kernel cache
+    pid_t child = fork();
+    assert(child >= 0);
+    if (child == 0) {
+        pause();
+        _exit(0);
+    }
+    assert(minielf::ProcessImageCache::findVdso(static_cast<int>(child)) == address);
+    auto childVdso = cache.getVdso(static_cast<int>(child));
+    assert(!childVdso || childVdso == vdso); // nullptr if ptrace access is denied
+    kill(child, SIGKILL);
+    waitpid(child, nullptr, 0);
+}
+
+// Checks per-section content hashes.
+static void testSectionHashes() {
+    std::string big(3 * 1024 * 1024 + 5, '\0');
+    for (size_t i = 0; i < big.size(); ++i) big[i] = static_cast<char>(i * 131 + (i >> 12));
+    auto build = [&](const std::string& text, bool extra) {
+        minielf_test::ElfWriter writer;
+        if (extra) writer.addSection({".data", 1, 0x3, 0, "padding"});
+        writer.addSection({".text", 1, 0x6, 0, text});
+        writer.addSection({".rodata", 1, 0x2, 0, big});
+        writer.addSection({".bss", 8 /* SHT_NOBITS */, 0x3, 0, "", 64});
+        writer.addSection({".empty", 1, 0x2, 0, ""});
+        return writer.build();
+    };
+    minielf::ParseOptions options;
+    options.hashSections = {".text", ".rodata", ".bss", ".empty"};
+
+    const std::string a = build("abc", false);
+    minielf::MemoryByteSource memory(a.data(), a.size());
+    minielf::MiniELF elf(memory, "a.o", options);
+    assert(elf.isValid());
+    // Reference XXH64 values
+    assert(elf.getSectionByName(".text")->hash == 0x44bc2cf5ad770999ULL);
+    assert(elf.getSectionByName(".empty")->hash == 0xef46db3751d8e999ULL);
+    assert(!elf.getSectionByName(".bss")->hash);
+    assert(!elf.getSectionByName(".symtab")->hash);
+
+    // Streaming reads without views hash the same as in-place views
+    XorSource streamed(a, 0x33);
+    minielf::MiniELF viaReads(streamed, "a.o", options);
+    assert(viaReads.getSectionByName(".rodata")->hash == elf.getSectionByName(".rodata")->hash);
+
+    // Same contents at other offsets hash equal; other contents differ
+    const std::string b = build("abc", true);
+    minielf::MiniELF moved(minielf::MemoryByteSource(b.data(), b.size()), "b.o", options);
+    assert(moved.getSectionByName(".text")->hash == elf.getSectionByName(".text")->hash);
+    assert(moved.getSectionByName(".rodata")->hash == elf.getSectionByName(".rodata")->hash);
+    const std::string c = build("abd", false);
+    minielf::MiniELF changed(minielf::MemoryByteSource(c.data(), c.size()), "c.o", options);
+    assert(changed.getSectionByName(".text")->hash != elf.getSectionByName(".text")->hash);
+
+    // hashAllSections hashes every section with contents
+    minielf::ParseOptions all;
+    all.hashAllSections = true;
+    minielf::MiniELF hashedAll(memory, "a.o", all);
+    assert(hashedAll.getSectionByName(".text")->hash == elf.getSectionByName(".text")->hash);
+    assert(hashedAll.getSectionByName(".symtab")->hash && hashedAll.getSectionByName(".empty")->hash);
+    assert(!hashedAll.getSectionByName(".bss")->hash && !hashedAll.getSections()[0].hash);
+
+    // Hashing after parsing reads only the named sections, once, without touching other handles
+    minielf::MiniELF later(memory, "a.o");
+    const minielf::MiniELF sharing = later;
+    assert(!later.getSectionByName(".text")->hash);
+    XorSource lateSource(a, 0x5a);
+    assert(later.hashSections(lateSource, {".text", ".bss"}));
+    assert(later.getSectionByName(".text")->hash == elf.getSectionByName(".text")->hash);
+    assert(!later.getSectionByName(".rodata")->hash && !later.getSectionByName(".bss")->hash);
+    assert(!sharing.getSectionByName(".text")->hash);
+    assert(later.hashSections(lateSource, {".text"}) && lateSource.reads == 1);
+    assert(!later.hashSections(minielf::MemoryByteSource(b.data(), b.size()), {".rodata"}));
+
+    // Without options nothing is hashed
+    minielf::MiniELF plain(a.data(), a.size());
+    assert(!plain.getSectionByName(".text")->hash);
+}
+
+// Checks the sorted-merge diff of two builds.
+static void testElfDiff() {
+    auto build = [](bool after) {
+        minielf_test::ElfWriter writer;
+        uint32_t text = writer.addSection({".text", 1, 0x6, 0, std::string(after ? 96 : 64, '\x90')});
+        writer.addSection({".rodata", 1, 0x2, 0, after ? "abcd" : "abce"});
+        writer.addSection({after ? ".data.new" : ".data.old", 1, 0x3, 0, "12345678"});
+        writer.addSymbol({"init", 0, 8, 0x02 /* STB_LOCAL|STT_FUNC */, text});
+        writer.addSymbol({"init", 8, after ? 12u : 4u, 0x02, text});
+        writer.addSymbol({"main", 16, 20, 0x12 /* STB_GLOBAL|STT_FUNC */, text});
+        writer.addSymbol({after ? "added" : "removed", 40, 6, 0x12, text});
+        writer.addSymbol({"table", 0, after ? 4u : 2u, 0x11 /* STB_GLOBAL|STT_OBJECT */, text});
+        if (!after) writer.addSymbol({"init", 48, 3, 0x12, text});
+        return writer.build();
+    };
+    minielf::ParseOptions options;
+    options.hashSections = {".text", ".rodata"};
+    const std::string a = build(false), b = build(true);
+    minielf::MiniELF before(minielf::MemoryByteSource(a.data(), a.size()), "before.o", options);
+    minielf::MiniELF after(minielf::MemoryByteSource(b.data(), b.size()), "after.o", options);
+    assert(before.isValid() && after.isValid());
+    minielf::ElfDiff diff(before, after);
+
+    std::vector<std::string> seen;
+    auto stats = diff.diffSymbols([&](const minielf::SymbolDiff& d) {
+        const auto* sym = d.before ? d.before : d.after;
+        seen.push_back(std::to_string(static_cast<int>(d.kind)) + sym->name);
+    });
+    // Duplicate names pair in symbol table order: the third "init" is removed
+    const std::vector<std::string> expected = {"0added", "2init", "1init", "1removed", "2table"};
+    assert(seen == expected);
+    assert(stats.added == 1 && stats.removed == 2 && stats.changed == 2);
+    assert(stats.sizeDelta == 6 + 8 - 3 - 6 + 2);
+
+    seen.clear();
+    stats = diff.diffSymbols(minielf::SymbolType::OBJECT, [&](const minielf::SymbolDiff& d) {
+        assert(d.kind == minielf::DiffKind::Resized && d.before->size == 2 && d.after->size == 4);
+        seen.push_back(d.after->name);
+    });
+    assert(seen.size() == 1 && stats.changed == 1 && stats.sizeDelta == 2);
+
+    // .symtab and .strtab differ too; check the sections built above
+    std::map<std::string, minielf::DiffKind> sections;
+    stats = diff.diffSections([&](const minielf::SectionDiff& d) {
+        sections[(d.before ? d.before : d.after)->name] = d.kind;
+    });
+    assert(sections.at(".data.new") == minielf::DiffKind::Added);
+    assert(sections.at(".data.old") == minielf::DiffKind::Removed);
+    assert(sections.at(".rodata") == minielf::DiffKind::Modified);
+    assert(sections.at(".text") == minielf::DiffKind::Resized);
+    assert(stats.added == 1 && stats.removed == 1);
+
+    // Identical builds have no differences
+    minielf::ElfDiff same(before, before);
+    assert(same.diffSymbols([](const minielf::SymbolDiff&) { assert(false); }).changed == 0);
+    assert(same.diffSections([](const minielf::SectionDiff&) { assert(false); }).added == 0);
+}
+
+// Checks that every level of a size report adds up and rolls up.
+static void checkSizeRollups(const minielf::SizeReport& report) {
+    uint64_t vm = 0, file = 0;
+    for (const auto& seg : report.getSegments()) {
+        vm += seg.vmSize;
+        file += seg.fileSize;
+    }
+    assert(vm == report.getVmSize() && file == report.getFileSize());
+    std::vector<uint64_t> segVm(report.getSegments().size()), segFile(report.getSegments().size());
+    for (size_t i = 0; i < report.getSections().size(); ++i) {
+        const auto& sec = report.getSections()[i];
+        segVm[sec.parent] += sec.vmSize;
+        segFile[sec.parent] += sec.fileSize;
+        auto symbols = report.getSymbolsInSection(i);
+        if (symbols.empty()) continue;
+        uint64_t symVm = 0;
+        for (const auto& sym : symbols) {
+            assert(sym.section == i);
+            symVm += sym.vmSize;
+        }
+        assert(symVm == sec.vmSize && !symbols[symbols.size() - 1].symbol);
+    }
+    for (size_t i = 0; i < segVm.size(); ++i) {
+        assert(segVm[i] == report.getSegments()[i].vmSize);
+        assert(segFile[i] == report.getSegments()[i].fileSize);
+    }
+}
+
+// Checks size attribution of a relocatable object and a linked executable.
+static void testSizeReport(const char* executable) {
+    minielf_test::ElfWriter writer;
+    uint32_t text = writer.addSection({".text", 1, 0x6, 0, std::string(100, '\x90')});
+    uint32_t bss = writer.addSection({".bss", 8 /* SHT_NOBITS */, 0x3, 0, "", 32});
+    writer.addSection({".comment", 1, 0, 0, "compiler"});
+    writer.addSymbol({"first", 0, 40, 0x12 /* STB_GLOBAL|STT_FUNC */, text});
+    writer.addSymbol({"alias", 0, 40, 0x12, text});      // Shadowed by "first"
+    writer.addSymbol({"nested", 30, 20, 0x02, text});    // Claims [40, 50) only
+    writer.addSymbol({"tail", 60, 100, 0x12, text});     // Clipped to the section
+    writer.addSymbol({"counter", 8, 8, 0x11 /* STB_GLOBAL|STT_OBJECT */, bss});
+    const std::string bytes = writer.build();
+    minielf::MiniELF obj(bytes.data(), bytes.size(), "sizes.o");
+    minielf::SizeReport report(obj);
+    checkSizeRollups(report);
+    assert(report.getSegments().size() == 1 && report.getSegments()[0].name == "[Unmapped]");
+    assert(report.getFileSize() == bytes.size() && report.getVmSize() == 132);
+
+    std::map<std::string, size_t> byName;
+    for (size_t i = 0; i < report.getSections().size(); ++i) byName[report.getSections()[i].name] = i;
+    assert(report.getSections()[byName.at(".comment")].vmSize == 0);
+    assert(report.getSections()[byName.at(".comment")].fileSize == 8);
+    assert(report.getSections()[byName.at("[ELF header]")].fileSize == sizeof(minielf::Elf64_Ehdr));
+    assert(byName.count("[Section headers]"));
+
+    auto textSymbols = report.getSymbolsInSection(byName.at(".text"));
+    std::vector<std::pair<std::string, uint64_t>> got;
+    for (const auto& sym : textSymbols) got.emplace_back(sym.symbol ? sym.symbol->name : "", sym.vmSize);
+    const std::vector<std::pair<std::string, uint64_t>> expected = {
+        {"first", 40}, {"nested", 10}, {"tail", 40}, {"", 10}};
+    assert(got == expected);
+    auto bssSymbols = report.getSymbolsInSection(byName.at(".bss"));
+    assert(bssSymbols.size() == 2 && bssSymbols[0].vmSize == 8 && bssSymbols[0].fileSize == 0);
+    assert(!bssSymbols[1].symbol && bssSymbols[1].vmSize == 24);
+
+    // A linked executable: sections roll up into the loadable segments
+    minielf::MiniELF exe(executable);
+    minielf::SizeReport linked(exe);
+    checkSizeRollups(linked);
+    assert(linked.getSegments().size() > 1);
+    assert(linked.getSegments()[0].name.rfind("LOAD #", 0) == 0);
+    const auto* main = exe.getSymbolByName("main");
+    bool foundMain = false;
+    for (const auto& sym : linked.getSymbols()) {
+        if (sym.symbol == main) {
+            foundMain = sym.vmSize == main->size && linked.getSections()[sym.section].name == ".text";
+        }
+    }
+    assert(foundMain);
+}
+
+// Checks address window queries against a brute-force filter.
+static void testAddressRanges() {
+    minielf_test::ElfWriter writer(2 /* ET_EXEC */);
+    uint32_t text = writer.addSection({".text", 1, 0x6, 0x1000, std::string(0x400, '\x90')});
+    writer.addSection({".data", 1, 0x3, 0x2000, std::string(0x40, '\0')});
+    writer.addSymbol({"outer", 0x1000, 0x200, 0x12 /* STB_GLOBAL|STT_FUNC */, text});
+    for (uint64_t a = 0x1010; a < 0x1100; a += 0x10)
+        writer.addSymbol({"inner" + std::to_string(a), a, 8, 0x02 /* STB_LOCAL|STT_FUNC */, text});
+    writer.addSymbol({"label", 0x1180, 0, 0x02, text});
+    writer.addSymbol({"after", 0x1200, 0x100, 0x12, text});
+    writer.addSymbol({"alias", 0x1200, 0x100, 0x12, text});
+    writer.addSymbol({"tail", 0x13f0, 0x10, 0x12, text});
+    const std::string bytes = writer.build();
+    minielf::MiniELF elf(bytes.data(), bytes.size(), "ranges");
+    assert(elf.isValid());
+
+    auto checkIn = [](const minielf::MiniELF& elf, uint64_t lo, uint64_t hi) {
+        std::vector<const minielf::Symbol*> expected, got;
+        for (const auto* sym : elf.getSymbolsSortedByAddress()) {
+            const uint64_t end = sym->address + (sym->size ? sym->size : 1);
+            if (lo < hi && sym->address < hi && end > lo) expected.push_back(sym);
+        }
+        for (const auto* sym : elf.getSymbolsInRange(lo, hi)) got.push_back(sym);
+        assert(got == expected);
+        std::vector<const minielf::Section*> sections;
+        for (const auto& sec : elf.getSections()) {
+            if (lo < hi && sec.address < hi && sec.address + (sec.size ? sec.size : 1) > lo) sections.push_back(&sec);
+        }
+        size_t count = 0;
+        for (const auto* sec : elf.getSectionsInRange(lo, hi)) {
+            assert(std::find(sections.begin(), sections.end(), sec) != sections.end());
+            ++count;
+        }
+        assert(count == sections.size());
+    };
+    auto check = [&](uint64_t lo, uint64_t hi) { checkIn(elf, lo, hi); };
+    for (uint64_t lo = 0xff0; lo < 0x1420; lo += 0x18)
+        for (uint64_t hi = lo; hi < 0x1440; hi += 0x44) check(lo, hi);
+    check(0, UINT64_MAX);
+
+    // Starting inside the window: the symbol straddling lo is reported first
+    auto window = elf.getSymbolsInRange(0x1105, 0x1300);
+    assert((*window.begin())->name == "outer");
+    auto starting = window.starting();
+    assert(starting.size() == 3 && starting[0]->name == "label");
+    assert(elf.getSymbolsInRange(0x1300, 0x1300).empty());
+    assert(elf.getSymbolsInRange(0x5000, 0x6000).empty());
+
+    // Only the symbols that straddle lo are visited, however long the enclosing symbol
+    minielf_test::ElfWriter nested(2 /* ET_EXEC */);
+    uint32_t nestedText = nested.addSection({".text", 1, 0x6, 0x100000, std::string(0x10000, '\x90')});
+    nested.addSymbol({"enclosing", 0x100000, 0x10000, 0x12, nestedText});
+    for (uint64_t a = 0x100000; a < 0x110000; a += 0x10)
+        nested.addSymbol({"f" + std::to_string(a), a, 0x10, 0x02, nestedText});
+    const std::string nestedBytes = nested.build();
+    minielf::MiniELF nestedElf(nestedBytes.data(), nestedBytes.size(), "nested");
+    auto late = nestedElf.getSymbolsInRange(0x10f008, 0x10f020);
+    assert(late.straddling().size() == 2 && late.straddling()[0]->name == "enclosing");
+    assert(late.straddling()[1]->name == "f" + std::to_string(0x10f000));
+    assert(late.starting().size() == 1);
+    size_t steps = 0;
+    for (auto it = late.begin(); it != late.end(); ++it) ++steps;
+    assert(steps == 3);
+    checkIn(nestedElf, 0x10f008, 0x10f020);
+
+    // Overlapping symbols with shared starts and ends, against the brute-force filter
+    minielf_test::ElfWriter overlapping(2 /* ET_EXEC */);
+    uint32_t overlappingText = overlapping.addSection({".text", 1, 0x6, 0x1000, std::string(0x1400, '\x90')});
+    uint32_t seed = 12345;
+    auto next = [&seed](uint32_t bound) { seed = seed * 1103515245u + 12345u; return (seed >> 8) % bound; };
+    for (int i = 0; i < 400; ++i) {
+        const uint64_t address = 0x1000 + 8 * next(0x200);
+        overlapping.addSymbol({"o" + std::to_string(i), address, 8 * next(0x40), 0x12, overlappingText});
+    }
+    const std::string overlappingBytes = overlapping.build();
+    minielf::MiniELF overlappingElf(overlappingBytes.data(), overlappingBytes.size(), "overlapping");
+    for (uint64_t lo = 0x1000; lo < 0x2400; lo += 0x1c)
+        checkIn(overlappingElf, lo, lo + 1 + next(0x100));
+
+    // Overlay symbols join the index
+    elf.addOverlaySymbols({{"jit", 0x1340, 0x10, minielf::SymbolType::FUNC}});
+    check(0x1300, 0x1400);
+    bool found = false;
+    for (const auto* sym : elf.getSymbolsInRange(0x1348, 0x1349)) found |= sym->name == "jit";
+    assert(found);
+
+    // Relocatable objects have no address space
+    minielf_test::ElfWriter object;
+    uint32_t objText = object.addSection({".text", 1, 0x6, 0, std::string(16, '\x90')});
+    object.addSymbol({"f", 0, 16, 0x12, objText});
+    const std::string objBytes = object.build();
+    minielf::MiniELF obj(objBytes.data(), objBytes.size(), "ranges.o");
+    assert(obj.getSymbolsInRange(0, 100).empty() && obj.getSectionsInRange(0, 100).empty());
+}
+
+// Checks lookups while the indexes are built in the background.
+static void testIndexWarming() {
+    minielf_test::ElfWriter writer(2 /* ET_EXEC */);
+    const uint32_t count = 200000;
+    uint32_t text = writer.addSection({".text", 8 /* SHT_NOBITS */, 0x6, 0x10000000, "", uint64_t(count) * 16});
+    for (uint32_t i = 0; i < count; ++i)
+        writer.addSymbol({"fn" + std::to_string(i), 0x10000000 + uint64_t(i) * 16, 12, 0x12 /* STB_GLOBAL|STT_FUNC */, text});
+    const std::string bytes = writer.build();
+    minielf::MemoryByteSource memory(bytes.data(), bytes.size());
+
+    for (auto warming : {minielf::IndexWarming::Fallback, minielf::IndexWarming::Wait}) {
+        minielf::ParseOptions options;
+        options.indexWarming = warming;
+        minielf::MiniELF elf(memory, "warm", options);
+        assert(elf.isValid());
+        // Answers are the same whether or not the indexes are ready yet
+        for (uint32_t i = 0; i < count; i += 997) {
+            const uint64_t address = 0x10000000 + uint64_t(i) * 16;
+            const auto* sym = elf.getSymbolByName("fn" + std::to_string(i));
+            assert(sym && sym->address == address);
+            assert(elf.getSymbolByAddress(address + 4) == sym);
+            assert(!elf.getSymbolByAddress(address + 12));
+            assert(elf.getNearestSymbol(address + 14) == sym);
+            assert(elf.getSectionByAddress(address)->name == ".text");
+        }
+        assert(!elf.getSymbolByName("missing") && !elf.getSymbolByName(""));
+        assert(elf.getSectionByName(".text")->index == text);
+        elf.waitForIndexes();
+        assert(elf.areIndexesReady());
+        assert(elf.getSymbolsByName("fn7").size() == 1);
+    }
+
+    // Indexes released after a Fallback warm-up are rebuilt on use, and lookups
+    // then see overlay symbols again instead of scanning the symbol table
+    {
+        minielf::ParseOptions options;
+        options.indexWarming = minielf::IndexWarming::Fallback;
+        minielf::MiniELF elf(memory, "released", options);
+        elf.waitForIndexes();
+        elf.releaseIndexes(minielf::LookupIndex::Addresses);
+        const uint64_t last = 0x10000000 + uint64_t(count - 1) * 16;
+        assert(elf.getNearestSymbol(last + 8)->name == "fn" + std::to_string(count - 1));
+        assert(elf.areIndexesReady(minielf::LookupIndex::Addresses));
+        elf.addOverlaySymbols({{"jit_fn", last + 0x40, 4, minielf::SymbolType::FUNC}}, 5);
+        assert(elf.getNearestSymbol(last + 0x41)->name == "jit_fn");
+        assert(elf.getSymbolByAddress(last + 0x41)->name == "jit_fn");
+    }
+
+    // Destroying an object while its indexes are still being built is safe
+    minielf::ParseOptions options;
+    options.indexWarming = minielf::IndexWarming::Wait;
+    { minielf::MiniELF discarded(memory, "discarded", options); }
+
+    // Without warming nothing is built until the first lookup, and each
+    // lookup builds only the index it needs
+    using minielf::LookupIndex;
+    minielf::MiniELF lazy(memory, "lazy");
+    assert(!lazy.areIndexesReady(LookupIndex::Names) && !lazy.areIndexesReady(LookupIndex::Addresses));
+    const auto* fn1 = lazy.getSymbolByName("fn1");
+    assert(fn1 && lazy.areIndexesReady(LookupIndex::Names));
+    assert(!lazy.areIndexesReady(LookupIndex::Addresses) && !lazy.areIndexesReady(LookupIndex::Sections));
+    assert(lazy.getNearestSymbol(fn1->address + 1) == fn1);
+    assert(lazy.areIndexesReady(LookupIndex::Addresses) && !lazy.areIndexesReady(LookupIndex::Sizes));
+    assert(lazy.getLargestSymbols(1).size() == 1 && lazy.areIndexesReady(LookupIndex::Sizes));
+    assert(!lazy.areIndexesReady(LookupIndex::Sections));
+
+    // Released indexes are rebuilt on demand
+    lazy.releaseIndexes(LookupIndex::Names | LookupIndex::Sizes);
+    assert(!lazy.areIndexesReady(LookupIndex::Names) && lazy.areIndexesReady(LookupIndex::Addresses));
+    assert(lazy.getSymbolByAddress(fn1->address) == fn1);
+    assert(lazy.getSymbolByName("fn1") == fn1);
+
+    // Overlays added while the address index is released are merged on rebuild
+    lazy.releaseIndexes();
+    assert(!lazy.areIndexesReady(LookupIndex::All));
+    lazy.addOverlaySymbols({{"jit_a", 0x9000, 0x10, minielf::SymbolType::FUNC},
+                            {"jit_b", 0x10000000, 0x4, minielf::SymbolType::FUNC}}, 2);
+    assert(!lazy.areIndexesReady(LookupIndex::Addresses));
+    assert(lazy.getSymbolByAddress(0x9008)->name == "jit_a");
+    assert(lazy.getSymbolByAddress(0x10000000)->name == "jit_b"); // Higher priority than fn0
+    lazy.addOverlaySymbols({{"jit_c", 0x9100, 0x10, minielf::SymbolType::FUNC}});
+    assert(lazy.getSymbolByAddress(0x9104)->name == "jit_c");
+    const auto sorted = lazy.getSymbolsSortedByAddress();
+    assert(std::is_sorted(sorted.begin(), sorted.end(),
+        [](const minielf::Symbol* a, const minielf::Symbol* b) { return a->address < b->address; }));
+    assert(sorted.size() == lazy.getSymbols().size() + 3 && lazy.getOverlaySymbolCount() == 3);
+}
+
+// Checks that copies share one parsed image and that moves and overlays keep handles independent.
+static void testSharedImages() {
+    using minielf::LookupIndex;
+    using minielf::SymbolType;
+    minielf_test::ElfWriter writer(2 /* ET_EXEC */);
+    uint32_t text = writer.addSection({".text", 1, 0x6, 0x401000, std::string(0x100, '\x90')});
+    writer.addSymbol({"alpha", 0x401000, 0x20, 0x12 /* STB_GLOBAL|STT_FUNC */, text});
+    writer.addSymbol({"beta", 0x401020, 0x20, 0x12, text});
+    const std::string bytes = writer.build();
+    minielf::MiniELF original(bytes.data(), bytes.size(), "shared");
+    assert(original.isValid());
+
+    // Copies share the parsed symbols and every index built through any of them
+    minielf::MiniELF copy = original;
+    assert(copy.getSymbols().data() == original.getSymbols().data());
+    const minielf::Symbol* alpha = original.getSymbolByName("alpha");
+    assert(alpha && copy.areIndexesReady(LookupIndex::Names));
+    assert(copy.getSymbolByName("alpha") == alpha);
+
+    // Threads copying one handle all resolve to the same symbols
+    std::vector<std::future<bool>> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.push_back(std::async(std::launch::async, [&original, alpha] {
+            bool same = true;
+            for (int i = 0; i < 1000; ++i) {
+                minielf::MiniELF local = original;
+                same &= local.getSymbolByAddress(0x401008) == alpha &&
+                        local.getSymbolByName("beta") == original.getSymbolByName("beta");
+            }
+            return same;
+        }));
+    }
+    for (auto& worker : workers) assert(worker.get());
+
+    // Indexes of a shared image are not released through one of its handles
+    copy.releaseIndexes();
+    assert(original.areIndexesReady(LookupIndex::Names) && copy.areIndexesReady(LookupIndex::Names));
+
+    // Overlays added through a handle give it its own image; the others are unaffected
+    copy.addOverlaySymbols({{"jit", 0x401040, 0x10, SymbolType::FUNC}});
+    assert(copy.getSymbols().data() != original.getSymbols().data());
+    assert(copy.getSymbolByAddress(0x401048)->name == "jit" && copy.getOverlaySymbolCount() == 1);
+    assert(!original.getSymbolByAddress(0x401048) && original.getOverlaySymbolCount() == 0);
+    assert(original.getSymbolByName("alpha") == alpha);
+    minielf::MiniELF overlaid = copy;
+    overlaid.addOverlaySymbols({{"jit_high", 0x401040, 0x10, SymbolType::FUNC}}, 2);
+    assert(overlaid.getSymbolByAddress(0x401048)->name == "jit_high" && overlaid.getOverlaySymbolCount() == 2);
+    overlaid.addOverlaySymbols({{"jit_low", 0x401040, 0x10, SymbolType::FUNC}}, 1);
+    assert(overlaid.getSymbolByAddress(0x401048)->name == "jit_high"); // Copied priorities still apply
+    assert(copy.getSymbolByAddress(0x401048)->name == "jit" && copy.getOverlaySymbolCount() == 1);
+
+    // Pointers stay valid while any handle shares the image; moved-from handles are empty
+    minielf::MiniELF survivor = copy;
+    {
+        minielf::MiniELF moved = std::move(original);
+        assert(moved.getSymbolByName("alpha") == alpha);
+        assert(!original.isValid() && original.getSymbols().empty());
+        assert(!original.getSymbolByName("alpha") && !original.getSymbolByAddress(0x401008));
+        survivor = moved;
+    }
+    assert(survivor.getSymbolByName("alpha") == alpha && alpha->address == 0x401000);
+    original = std::move(survivor);
+    assert(original.getSymbolByName("alpha") == alpha && !survivor.isValid());
+    const std::string junk(64, 'x');
+    minielf::MiniELF broken(junk.data(), junk.size(), "junk");
+    const std::string brokenError = broken.getLastError();
+    minielf::MiniELF constructed(std::move(broken));
+    assert(!brokenError.empty() && constructed.getLastError() == brokenError && broken.getLastError().empty());
+    minielf::MiniELF assigned = copy;
+    assigned = std::move(constructed);
+    assert(assigned.getLastError() == brokenError && constructed.getLastError().empty());
+
+    // Moving a handle while its indexes are built in the background is safe
+    minielf::ParseOptions options;
+    options.indexWarming = minielf::IndexWarming::Wait;
+    minielf::MemoryByteSource memory(bytes.data(), bytes.size());
+    minielf::MiniELF warming(memory, "warming", options);
+    minielf::MiniELF taken = std::move(warming);
+    taken.waitForIndexes();
+    assert(taken.areIndexesReady() && taken.getSymbolByName("beta")->address == 0x401020);
+}
+
+int main(int argc, char** argv) {
     // Path to a test ELF file (ensure this file exists for the test to pass)
     const char* path = "../tests/test_elf_file";
     minielf::MiniELF elf(path);
@@ -100,6 +1219,43 @@ int main() {
            stage == minielf::MiniELF::ParseStage::Symbols ||
            stage == minielf::MiniELF::ParseStage::ProgramHeaders);
 
+    // Test: section-relative lookups on a linked file
+    const auto* main_text = elf.getSectionByAddress(sym_by_name->address);
+    assert(main_text && sym_by_name->sectionIndex == main_text->index);
+    assert(!elf.isRelocatable());
+    assert(elf.getSymbolBySectionOffset(main_text->index,
+                                        sym_by_name->address - main_text->address) == sym_by_name);
+
+    // Test: mapped view of the linked file at a PIE-style base
+    const uint64_t base = meta.type == 3 /* ET_DYN */ ? 0x555555554000 : 0;
+    uint64_t firstLoad = 0;
+    for (const auto& ph : phdrs) {
+        if (ph.p_type == 1 /* PT_LOAD */) { firstLoad = ph.p_vaddr - ph.p_offset; break; }
+    }
+    auto view = minielf::MappedView::fromMapping(elf, base + firstLoad, 0);
+    assert(view.getBias() == base);
+    assert(view.getNearestSymbol(view.toRuntimeAddress(sym_by_name->address) + 1) == sym_by_name);
+    assert(view.contains(view.getRuntimeAddress(*sym_by_name)));
+
+    if (argc > 1) testRelocatable(argv[1]);
+    testExtendedNumbering();
+    testMalformedProgramHeaderCount();
+    testSizeIndex();
+    testDuplicateNames();
+    testStringViewLookups();
+    testExporters();
+    testOverlaySymbols();
+    testMappedViews();
+    testByteSources(path);
+    testProcessImage();
+    testVdso();
+    testSectionHashes();
+    testElfDiff();
+    testSizeReport(path);
+    testAddressRanges();
+    testIndexWarming();
+    testSharedImages();
+
     // Test: getValidationLog
     std::string log = elf.getValidationLog();
     assert(!log.empty());
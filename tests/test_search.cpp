@@ -0,0 +1,263 @@
+#include "minielf/NgramIndex.hpp"
+#include "minielf/NameScanner.hpp"
+#include "minielf/DemangledIndex.hpp"
+#include "ElfWriter.hpp"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @file test_search.cpp
+ * @brief Unit tests for symbol name search.
+ *
+ * The tests ensure that:
+ *   - The trigram index finds fragments inside mangled names.
+ *   - Substring results match a linear scan, independently of the thread count.
+ *   - Fuzzy queries find names within the edit distance bound, ranked by distance.
+ *   - The raw string table scanner maps substring and regex hits back to symbols,
+ *     including names tail-merged into longer strings.
+ *   - The demangled name index answers exact, prefix and qualified-name queries.
+ */
+
+// Builds an in-memory object holding one function symbol per name.
+static std::string buildObject(const std::vector<std::string>& names, bool tailMerge = false) {
+    minielf_test::ElfWriter writer;
+    writer.setTailMerge(tailMerge);
+    uint32_t text = writer.addSection({".text", 1, 0x6, 0, std::string(16, '\x90')});
+    uint64_t offset = 0;
+    for (const auto& name : names) writer.addSymbol({name, offset++, 1, 0x12, text});
+    return writer.build();
+}
+
+// Collects the names of a result list.
+static std::set<std::string> namesOf(const std::vector<minielf::SymbolMatch>& matches) {
+    std::set<std::string> names;
+    for (const auto& m : matches) names.insert(m.symbol->name);
+    return names;
+}
+
+static void testNgramIndex() {
+    const std::vector<std::string> names = {
+        "_ZN5myapp6Parser11parseHeaderEv",
+        "_ZN5myapp6Parser3runEv",
+        "_ZN5myapp6Writer11writeHeaderEv",
+        "parse_header_v2",
+        "parseHeader",
+        "init",
+    };
+    std::string bytes = buildObject(names);
+    minielf::MiniELF elf(bytes.data(), bytes.size(), "search.o");
+    assert(elf.isValid());
+
+    minielf::NgramIndex index(elf, 2);
+    assert(index.getTrigramCount() > 0);
+    assert(index.getPostingsSize() > 0);
+
+    auto hits = index.findSubstring("parseHeader");
+    assert(hits.size() == 2);
+    assert(hits[0].symbol->name == "parseHeader"); // exact match ranks first
+    assert(hits[1].symbol->name == "_ZN5myapp6Parser11parseHeaderEv");
+
+    assert(namesOf(index.findSubstring("Header")).size() == 3);
+    assert(index.findSubstring("nothing_like_this").empty());
+    assert(index.findSubstring("in").size() == 1); // short pattern: scan fallback
+    assert(index.findSubstring("Header", 1).size() == 1);
+
+    auto fuzzy = index.findFuzzy("parseHeadr", 1);
+    assert(namesOf(fuzzy) == std::set<std::string>({"parseHeader", "_ZN5myapp6Parser11parseHeaderEv"}));
+    for (const auto& m : fuzzy) assert(m.distance == 1);
+
+    auto ranked = index.findFuzzy("writeHeader", 2);
+    assert(!ranked.empty() && ranked[0].distance == 0);
+    assert(ranked[0].symbol->name == "_ZN5myapp6Writer11writeHeaderEv");
+    for (size_t i = 1; i < ranked.size(); ++i) assert(ranked[i - 1].distance <= ranked[i].distance);
+    assert(index.findFuzzy("xyzzyxyzzy", 1).empty());
+}
+
+static void testAgainstLinearScan() {
+    std::mt19937 rng(1234);
+    const std::string alphabet = "abcdefgh_";
+    std::vector<std::string> names;
+    for (int i = 0; i < 3000; ++i) {
+        std::string name;
+        size_t len = 4 + rng() % 20;
+        for (size_t j = 0; j < len; ++j) name.push_back(alphabet[rng() % alphabet.size()]);
+        names.push_back(name);
+    }
+    std::string bytes = buildObject(names);
+    minielf::MiniELF elf(bytes.data(), bytes.size(), "random.o");
+    minielf::NgramIndex serial(elf, 1);
+    minielf::NgramIndex parallel(elf, 4);
+    assert(serial.getPostingsSize() == parallel.getPostingsSize());
+
+    for (int q = 0; q < 50; ++q) {
+        const std::string& src = names[rng() % names.size()];
+        size_t len = std::min<size_t>(src.size(), 3 + rng() % 4);
+        std::string pattern = src.substr(rng() % (src.size() - len + 1), len);
+
+        std::set<std::string> expected;
+        for (const auto& n : names) if (n.find(pattern) != std::string::npos) expected.insert(n);
+        assert(namesOf(serial.findSubstring(pattern, SIZE_MAX)) == expected);
+        assert(namesOf(parallel.findSubstring(pattern, SIZE_MAX)) == expected);
+    }
+}
+
+// Collects the names of symbol indices.
+static std::set<std::string> namesOf(const minielf::MiniELF& elf, const std::vector<uint32_t>& ids) {
+    std::set<std::string> names;
+    for (uint32_t id : ids) names.insert(elf.getSymbols()[id].name);
+    return names;
+}
+
+static void testNameScanner() {
+    // "header" is written after "parse_header" and shares its tail
+    std::string bytes = buildObject({"parse_header", "my_header_v2", "header", "init", "run"}, true);
+    minielf::MiniELF elf(bytes.data(), bytes.size(), "scan.o");
+    assert(elf.isValid());
+    assert(elf.getSymbolNameOffsets().size() == elf.getSymbols().size());
+    const auto& offsets = elf.getSymbolNameOffsets();
+    assert(offsets[3] == offsets[1] + 6); // "header" points into "parse_header"
+
+    minielf::NameScanner scanner(elf, 3);
+    auto hits = scanner.findContaining("header");
+    assert(hits.size() == 3);
+    assert(std::is_sorted(hits.begin(), hits.end()));
+    assert(namesOf(elf, hits) == std::set<std::string>({"parse_header", "my_header_v2", "header"}));
+    assert(namesOf(elf, scanner.findContaining("parse")) == std::set<std::string>({"parse_header"}));
+    assert(scanner.findContaining("absent").empty());
+    assert(scanner.findContaining("").empty());
+
+    assert(namesOf(elf, scanner.findMatching("^parse_\\w+$")) == std::set<std::string>({"parse_header"}));
+    assert(namesOf(elf, scanner.findMatching("^header$")) == std::set<std::string>({"header"}));
+    assert(namesOf(elf, scanner.findMatching("^(init|run)$")) == std::set<std::string>({"init", "run"}));
+    assert(scanner.findMatching("HEADER", std::regex::ECMAScript | std::regex::icase).size() == 3);
+
+    assert(minielf::NameScanner::requiredLiteral("parse[A-Z]\\w+") == "parse");
+    assert(minielf::NameScanner::requiredLiteral("^_ZN5myapp6Parser") == "_ZN5myapp6Parser");
+    assert(minielf::NameScanner::requiredLiteral("foo|bar").empty());
+    assert(minielf::NameScanner::requiredLiteral("x{2}yz") == "yz");
+    assert(minielf::NameScanner::requiredLiteral("a\\.b(cdefgh)?") == "a.b");
+    // Code point escapes and back-references are skipped whole, not read as literals
+    assert(minielf::NameScanner::requiredLiteral("ma\\x69n") == "ma");
+    assert(minielf::NameScanner::requiredLiteral("\\u0070arse_h") == "arse_h");
+    assert(minielf::NameScanner::requiredLiteral("(he)ad\\12er") == "ad");
+    assert(minielf::NameScanner::requiredLiteral("x\\cJyz") == "yz");
+    assert(namesOf(elf, scanner.findMatching("p\\x61rse")) == std::set<std::string>({"parse_header"}));
+    assert(scanner.findMatching("he\\x61der").size() == 3);
+
+    // Randomized comparison with a linear scan, several chunk layouts
+    std::mt19937 rng(99);
+    std::vector<std::string> names;
+    for (int i = 0; i < 2000; ++i) {
+        std::string name;
+        size_t len = 1 + rng() % 12;
+        for (size_t j = 0; j < len; ++j) name.push_back("abc_"[rng() % 4]);
+        names.push_back(name);
+    }
+    std::string randomBytes = buildObject(names, true);
+    minielf::MiniELF randomElf(randomBytes.data(), randomBytes.size(), "random_scan.o");
+    for (unsigned threads : {1u, 2u, 7u}) {
+        minielf::NameScanner randomScanner(randomElf, threads);
+        for (const char* needle : {"a", "ab", "c_c", "abca", "____"}) {
+            std::vector<uint32_t> expected;
+            for (uint32_t i = 0; i < randomElf.getSymbols().size(); ++i) {
+                const auto& name = randomElf.getSymbols()[i].name;
+                if (!name.empty() && name.find(needle) != std::string::npos) expected.push_back(i);
+            }
+            assert(randomScanner.findContaining(needle) == expected);
+        }
+    }
+}
+
+// Collects the names of a symbol list.
+static std::vector<std::string> namesOf(const std::vector<const minielf::Symbol*>& symbols) {
+    std::vector<std::string> names;
+    for (const auto* sym : symbols) names.push_back(sym->name);
+    return names;
+}
+
+static void testDemangledIndex() {
+    std::string bytes = buildObject({
+        "_ZN5myapp6Parser3runEv",   // myapp::Parser::run()
+        "_ZN5myapp6Parser3runEi",   // myapp::Parser::run(int)
+        "_ZNK5myapp6Parser4sizeEv", // myapp::Parser::size() const
+        "_ZN5myapp6Parser7runtimeE",// myapp::Parser::runtime
+        "_ZN5myapp6Writer5flushEv", // myapp::Writer::flush()
+        "_Z3fooi",                  // foo(int)
+        "main",
+        "_Zbroken",
+    });
+    minielf::MiniELF elf(bytes.data(), bytes.size(), "demangle.o");
+    assert(elf.isValid());
+    assert(minielf::DemangledIndex::demangle("_ZN5myapp6Parser3runEi") == "myapp::Parser::run(int)");
+    assert(minielf::DemangledIndex::demangle("main").empty());
+    assert(minielf::DemangledIndex::demangle("_Zbroken").empty());
+
+    for (unsigned threads : {1u, 3u}) {
+        minielf::DemangledIndex index(elf, threads);
+        assert(index.size() == 6); // plain and malformed names are not indexed
+        for (size_t i = 1; i < index.size(); ++i) assert(index.getName(i - 1) <= index.getName(i));
+
+        auto exact = index.findExact("myapp::Parser::run(int)");
+        assert(exact.size() == 1 && exact[0]->name == "_ZN5myapp6Parser3runEi");
+        assert(index.findExact("myapp::Parser::run").empty());
+        assert(index.findExact("main").empty());
+
+        auto prefix = index.findPrefix("myapp::Parser::");
+        assert(prefix.size() == 4);
+        assert(index.findPrefix("myapp::").size() == 5);
+        assert(index.findPrefix("zzz").empty());
+
+        // Overloads match, "runtime" does not
+        assert(namesOf(index.findQualified("myapp::Parser::run")) ==
+               std::vector<std::string>({"_ZN5myapp6Parser3runEv", "_ZN5myapp6Parser3runEi"}));
+        assert(namesOf(index.findQualified("myapp::Parser::size")) ==
+               std::vector<std::string>({"_ZNK5myapp6Parser4sizeEv"}));
+        assert(namesOf(index.findQualified("myapp::Parser::runtime")) ==
+               std::vector<std::string>({"_ZN5myapp6Parser7runtimeE"}));
+        assert(index.findQualified("myapp::Parser").empty());
+    }
+
+    // Return types, operators and local entities around the qualified name
+    std::string templates = buildObject({
+        "_ZN2ns5twiceIiEET_S1_",  // int ns::twice<int>(int)
+        "_ZN2ns5twiceIdEET_S1_",  // double ns::twice<double>(double)
+        "_ZN2nslsIcEERSoS1_PKT_", // std::ostream& ns::operator<< <char>(std::ostream&, char const*)
+        "_ZN2ns1PcviEv",          // ns::P::operator int()
+        "_ZN2ns1PclEv",           // ns::P::operator()()
+        "_ZN2ns1PnwEm",           // ns::P::operator new(unsigned long)
+        "_ZN2ns1P3runEv",         // ns::P::run()
+        "_ZZN2ns1P3runEvE5count", // ns::P::run()::count
+        "_ZN12_GLOBAL__N_14helpEv", // (anonymous namespace)::help()
+        "_ZTVN2ns1PE",            // vtable for ns::P
+    });
+    minielf::MiniELF templateElf(templates.data(), templates.size(), "templates.o");
+    assert(templateElf.isValid());
+    minielf::DemangledIndex index(templateElf);
+    assert(namesOf(index.findQualified("ns::twice<int>")) == std::vector<std::string>({"_ZN2ns5twiceIiEET_S1_"}));
+    assert(namesOf(index.findQualified("ns::twice<double>")) == std::vector<std::string>({"_ZN2ns5twiceIdEET_S1_"}));
+    assert(index.findQualified("int ns::twice<int>").empty());
+    assert(namesOf(index.findQualified("ns::operator<< <char>")) == std::vector<std::string>({"_ZN2nslsIcEERSoS1_PKT_"}));
+    assert(namesOf(index.findQualified("ns::P::operator int")) == std::vector<std::string>({"_ZN2ns1PcviEv"}));
+    assert(namesOf(index.findQualified("ns::P::operator()")) == std::vector<std::string>({"_ZN2ns1PclEv"}));
+    assert(namesOf(index.findQualified("ns::P::operator new")) == std::vector<std::string>({"_ZN2ns1PnwEm"}));
+    assert(namesOf(index.findQualified("ns::P::run")) == std::vector<std::string>({"_ZN2ns1P3runEv"}));
+    assert(namesOf(index.findQualified("ns::P::run()::count")) == std::vector<std::string>({"_ZZN2ns1P3runEvE5count"}));
+    assert(namesOf(index.findQualified("(anonymous namespace)::help")) ==
+           std::vector<std::string>({"_ZN12_GLOBAL__N_14helpEv"}));
+    assert(namesOf(index.findQualified("vtable for ns::P")) == std::vector<std::string>({"_ZTVN2ns1PE"}));
+    assert(index.findQualified("ns::P").empty());
+}
+
+int main() {
+    testNgramIndex();
+    testAgainstLinearScan();
+    testNameScanner();
+    testDemangledIndex();
+    std::cout << "All search tests passed.\n";
+    return 0;
+}